@@ -0,0 +1,1128 @@
+// Synthetic benchmark workloads for the booking engine.
+//
+//   days [N]     - drive a HiltonHotel through N simulated days (default 365):
+//                  reserving rooms, undoing some bookings, reporting, saving
+//                  and reloading the per-day files
+//   import [Y]   - write Y years (default 5) of day files for a 500-room
+//                  hotel, then bulk import them
+//   catalog [N]  - build N Hilton catalogs (default 20000) and run room
+//                  lookups, compile-time tables vs. the runtime-built map
+//   assign [N]   - book N random future stays (default 40000) into a
+//                  500-room hotel with first-fit and with best-fit room
+//                  assignment, then run the nightly re-optimization
+//   snapshot [N] - one thread books and undoes N reservations (default
+//                  200000) while reader threads scan snapshots and check
+//                  that every view is consistent
+//   memory [N]   - book N stays (default 200000) over ten years and report
+//                  tracked bytes, peak bytes and RSS as the store grows
+//   export [Y]   - write Y years (default 5) of day files, export them and
+//                  an imported store to columnar files, then compare full
+//                  and one-month scans against scraping the CSVs
+//   forecast [Y] - import Y years (default 2) of day files, forecast the
+//                  next 90 nights from 120 days before the end, check it
+//                  against the final bookings, then time refreshes
+//   shards [N]   - route N bookings (default 20000) through a coordinator
+//                  to 1, 2 and 4 worker processes and to four date-range
+//                  shards, then time portfolio revenue (POSIX only)
+//   lazy [Y]     - write Y years (default 5) of day files, then compare
+//                  time-to-first-booking after a full import with attaching
+//                  the files as lazily paged history, and time skewed day
+//                  queries under a small LRU budget and guest lookups
+//   replay [N]   - record a trace of N operations (default 20000) over 60
+//                  days of history, then replay it three times, checking
+//                  rooms and state hashes and timing the operations
+//   all          - every workload at its default size (the default)
+//
+// The `all` run is the training workload for the profile-guided-optimization
+// build (see CMakeLists.txt).
+//
+// Usage: hotel_bench [workload] [size]
+
+#include "columnar.h"
+#include "history.h"
+#include "hotel.h"
+#include "replay.h"
+#ifdef HOTEL_HAVE_SHARDS
+#include "shard.h"
+#endif
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <streambuf>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace std;
+
+namespace {
+
+// Swallows everything written to it (the engine prints on every call)
+class NullBuffer : public std::streambuf {
+protected:
+    int overflow(int c) override { return c; }
+};
+
+// Redirects std::cout to a NullBuffer for the lifetime of the object
+class QuietScope {
+public:
+    QuietScope() : saved(std::cout.rdbuf(&sink)) {}
+    ~QuietScope() { std::cout.rdbuf(saved); }
+
+private:
+    NullBuffer sink;
+    std::streambuf* saved;
+};
+
+// Consecutive MM-DD-YYYY dates starting at 01-01-<year>
+std::vector<std::string> makeDates(int count, int year) {
+    static const int daysInMonth[] = { 31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31 };
+    std::vector<std::string> dates;
+    int month = 1;
+    int day = 1;
+    for (int i = 0; i < count; ++i) {
+        char buffer[40];
+        std::snprintf(buffer, sizeof(buffer), "%02d-%02d-%04d", month, day, year);
+        dates.push_back(buffer);
+
+        bool leap = (year % 4 == 0 && year % 100 != 0) || year % 400 == 0;
+        int monthLength = daysInMonth[month - 1] + ((month == 2 && leap) ? 1 : 0);
+        if (++day > monthLength) {
+            day = 1;
+            if (++month > 12) {
+                month = 1;
+                ++year;
+            }
+        }
+    }
+    return dates;
+}
+
+void report(const std::string& label, long operations,
+            std::chrono::steady_clock::duration elapsed) {
+    double seconds = std::chrono::duration<double>(elapsed).count();
+    std::cout << std::left << std::setw(14) << label
+              << std::right << std::setw(10) << operations << " ops "
+              << std::fixed << std::setprecision(3) << std::setw(9)
+              << seconds * 1000.0 << " ms "
+              << std::setprecision(0) << std::setw(12)
+              << (seconds > 0 ? operations / seconds : 0.0) << " ops/s\n";
+}
+
+// Runtime-configured 500-room property: five floors of 100 rooms,
+// one room type per floor, rooms on a floor connected in a corridor
+class SyntheticHotel : public Hotel {
+public:
+    SyntheticHotel() : Hotel("Synthetic", 500) {
+        static const char* const typeNames[] = {
+            "Floor 1 Standard", "Floor 2 Standard", "Floor 3 Superior",
+            "Floor 4 Deluxe", "Floor 5 Suite"
+        };
+        for (int floor = 1; floor <= 5; ++floor) {
+            int first = floor * 100 + 1;
+            int last = floor * 100 + 100;
+            RoomType& rt = roomTypes[typeNames[floor - 1]];
+            rt = { typeNames[floor - 1], 100, 100, 100.0 + 50.0 * floor,
+                   std::to_string(first) + " thru " + std::to_string(last), {}, {}, {} };
+            for (int room = first; room <= last; ++room) {
+                rt.availableRoomNumbers.push_back(room);
+                rt.allRoomNumbers.push_back(room);
+                if (room > first) addGraphEdge(room - 1, room);
+            }
+        }
+        publishSnapshot();
+    }
+};
+
+// The Hilton layout built the runtime way (string-keyed map + push_back
+// loops + adjacency map), kept as the baseline for the compile-time catalog
+class RuntimeHiltonHotel : public Hotel {
+public:
+    RuntimeHiltonHotel(int totalRooms) : Hotel("Hilton", totalRooms) {
+        for (const RoomRangeSpec& spec : hiltonRooms) {
+            int count = spec.lastRoom - spec.firstRoom + 1;
+            roomTypes[spec.typeName] =
+            { spec.typeName, count, count, spec.pricePerNight, spec.rangeLabel, {}, {}, {} };
+            for (int i = spec.firstRoom; i <= spec.lastRoom; ++i) {
+                roomTypes[spec.typeName].availableRoomNumbers.push_back(i);
+                roomTypes[spec.typeName].allRoomNumbers.push_back(i);
+            }
+            for (int r = spec.firstRoom; r < spec.lastRoom; ++r) {
+                addGraphEdge(r, r + 1);
+            }
+        }
+        publishSnapshot();
+    }
+};
+
+// Exposes the catalog lookups of either Hilton flavour to the benchmark
+template <class Base>
+class CatalogProbe : public Base {
+public:
+    CatalogProbe() : Base(122) {}
+
+    // Type lookup + menu lookup + neighbour walk for every room number
+    double lookupAll(int firstRoom, int lastRoom) {
+        double checksum = 0.0;
+        for (int room = firstRoom; room <= lastRoom; ++room) {
+            auto it = this->roomTypeForRoom(room);
+            if (it == this->roomTypes.end()) continue;
+            checksum += it->second.pricePerNight;
+            checksum += this->roomTypeByOption(1 + room % 4)->second.totalRooms;
+
+            const int* neighbors = nullptr;
+            size_t count = 0;
+            if (this->roomNeighbors(room, neighbors, count)) {
+                for (size_t i = 0; i < count; ++i) checksum += neighbors[i];
+            }
+        }
+        return checksum;
+    }
+};
+
+// Small deterministic generator so every run sees the same data
+class Lcg {
+public:
+    explicit Lcg(unsigned long long seed) : state(seed) {}
+    unsigned next(unsigned bound) {
+        state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+        return static_cast<unsigned>((state >> 33) % bound);
+    }
+
+private:
+    unsigned long long state;
+};
+
+using Clock = std::chrono::steady_clock;
+namespace fs = std::filesystem;
+
+void runDays(int days) {
+    const std::vector<std::string> dates = makeDates(days, 2025);
+    const int roomTypeCount = 4;
+    const int bookingsPerDay = 100;
+    HiltonHotel hotel(122);
+    // As the CLI does: bookings read the days they look back on through the store
+    hotel.attachHistory(".");
+
+    long reserveOps = 0;
+    long loadOps = 0;
+    long lookupOps = 0;
+    Clock::duration reserveTime{};
+    Clock::duration loadTime{};
+    Clock::duration lookupTime{};
+
+    {
+        QuietScope quiet;
+
+        // Reserve / undo / report / save, one simulated day at a time
+        Clock::time_point start = Clock::now();
+        for (size_t d = 0; d < dates.size(); ++d) {
+            const std::string& date = dates[d];
+            hotel.loadFromFile(date);
+            for (int i = 0; i < bookingsPerDay; ++i) {
+                std::string guest = "Guest" + std::to_string(d * bookingsPerDay + i);
+                int option = 1 + (i % roomTypeCount);
+                hotel.reserveRoom(option, guest, date, date, i % 24, 1 + (i % 5));
+                ++reserveOps;
+                if (i % 10 == 9) {
+                    hotel.undoLastBooking();
+                    ++reserveOps;
+                }
+            }
+            hotel.getTotal();
+            hotel.displayRoomAvailability();
+            hotel.saveToFile(date);
+        }
+        reserveTime = Clock::now() - start;
+
+        // Reload every saved day file
+        start = Clock::now();
+        for (const std::string& date : dates) {
+            hotel.loadFromFile(date);
+            ++loadOps;
+        }
+        loadTime = Clock::now() - start;
+
+        // Lookups against the last loaded day
+        start = Clock::now();
+        for (int i = 0; i < bookingsPerDay * 20; ++i) {
+            std::string guest = "Guest" + std::to_string(((days - 1) * bookingsPerDay) + (i % bookingsPerDay));
+            hotel.findGuestReservations(guest);
+            hotel.bfsFromRoom(101 + (i % 70));
+            hotel.showReservationsForDate(dates.back());
+            lookupOps += 3;
+        }
+        lookupTime = Clock::now() - start;
+    }
+
+    std::cout << "days: " << days << " simulated days\n";
+    report("reserve", reserveOps, reserveTime);
+    report("load", loadOps, loadTime);
+    report("lookup", lookupOps, lookupTime);
+}
+
+// Write years of day files into a directory under the scratch directory:
+// 60-95% of rooms offered per day (a room still held by an earlier
+// multi-night stay is skipped), a legacy two-column file every 100 days and
+// one double-booked row every 250 days. Current-format rows were booked
+// 0-20 days ahead, a quarter of them up to 119 days ahead.
+fs::path writeHistory(int years, const std::string& name) {
+    const std::vector<std::string> dates = makeDates(years * 365, 2020);
+    const fs::path historyDir = fs::current_path() / name;
+    fs::create_directories(historyDir);
+    const int firstDay = Hotel::dateToDayNumber(dates[0]);
+
+    Lcg rng(42);
+    Lcg leadRng(7);
+    std::vector<size_t> busyUntil(500, 0);
+    for (size_t d = 0; d < dates.size(); ++d) {
+        std::ofstream out(historyDir / (dates[d] + ".txt"));
+        bool legacy = d % 100 == 99;
+        int occupied = 300 + static_cast<int>(rng.next(176));
+        std::string body;
+        double revenue = 0.0;
+        for (int i = 0; i < occupied; ++i) {
+            if (busyUntil[i] > d) continue;
+            int floor = 1 + i / 100;
+            int room = floor * 100 + 1 + (i % 100);
+            std::string guest = "G" + std::to_string(rng.next(200000));
+            int nights = 1 + static_cast<int>(rng.next(4));
+            double price = 100.0 + 50.0 * floor;
+            busyUntil[i] = d + (legacy ? 1 : nights);
+            if (legacy) {
+                body += guest + "," + std::to_string(room) + "\n";
+                continue;
+            }
+            revenue += price * nights;
+            int lead = static_cast<int>(leadRng.next(4) == 0 ? leadRng.next(120) : leadRng.next(21));
+            body += guest + "," + std::to_string(room) + ",Floor " + std::to_string(floor) +
+                    (floor <= 2 ? " Standard," : floor == 3 ? " Superior," : floor == 4 ? " Deluxe," : " Suite,") +
+                    dates[d] + "," + std::to_string(nights) + "," +
+                    std::to_string(12 + static_cast<int>(rng.next(10))) + "," +
+                    std::to_string(price) + "," + std::to_string(price * nights) + "," +
+                    Hotel::dayNumberToDate(firstDay + static_cast<int>(d) - lead) + "\n";
+        }
+        if (d % 250 == 249 && busyUntil[0] > d) {
+            body += "Duplicate," + std::to_string(101) + ",Floor 1 Standard," + dates[d] +
+                    ",1,15,150,150\n";
+        }
+        if (legacy) {
+            out << "$0\n" << body;
+        } else {
+            out << "TOTAL_REVENUE=" << revenue << "\n"
+                << "GuestName,RoomNumber,RoomType,StayDate,Nights,CheckInHour,PricePerNight,TotalCost,BookedOn\n"
+                << body;
+        }
+    }
+    return historyDir;
+}
+
+void runImport(int years) {
+    const fs::path historyDir = writeHistory(years, "history");
+
+    SyntheticHotel hotel;
+    Hotel::ImportReport result;
+    Clock::time_point start = Clock::now();
+    {
+        QuietScope quiet;
+        result = hotel.importDirectory(historyDir.string());
+    }
+    Clock::duration importTime = Clock::now() - start;
+
+    std::cout << "import: " << years << " years, " << result.filesFound << " files, "
+              << result.imported << " of " << result.rowsParsed << " rows imported, "
+              << result.conflicts.size() << " conflicts (parse "
+              << std::fixed << std::setprecision(1) << result.parseMillis << " ms, merge "
+              << result.mergeMillis << " ms)\n";
+    report("import", static_cast<long>(result.rowsParsed), importTime);
+
+    // The Hilton room types hold commas; every saved row must import again
+    const fs::path hiltonDir = fs::current_path() / "hilton-files";
+    fs::create_directories(hiltonDir);
+    fs::current_path(hiltonDir);
+    size_t saved = 0;
+    {
+        QuietScope quiet;
+        HiltonHotel source(122);
+        const std::vector<std::string> days = makeDates(30, 2025);
+        for (size_t d = 0; d < days.size(); ++d) {
+            for (int option = 1; option <= 4; ++option) {
+                std::string guest = "Guest, " + std::to_string(d * 4 + option);
+                if (source.reserveRoom(option, guest, days[d], days[d], 15, 1) > 0) ++saved;
+            }
+            source.saveToFile(days[d]);
+        }
+    }
+
+    // Imported from an empty working directory, so day files other
+    // workloads left in the scratch directory are not merged in
+    const fs::path targetDir = hiltonDir.parent_path() / "hilton-import";
+    fs::create_directories(targetDir);
+    fs::current_path(targetDir);
+    Hotel::ImportReport hilton;
+    {
+        HiltonHotel target(122);
+        QuietScope quiet;
+        hilton = target.importDirectory(hiltonDir.string());
+    }
+    fs::current_path(hiltonDir.parent_path());
+    std::cout << "import: Hilton files, " << hilton.imported << " of " << saved << " saved rows imported, "
+              << hilton.conflicts.size() << " conflicts"
+              << (hilton.imported == saved && hilton.conflicts.empty() ? "" : "  ** MISMATCH **") << "\n";
+}
+
+// Exposes booked-stay counts and long-stay capacity to the benchmark
+class AssignProbe : public SyntheticHotel {
+public:
+    size_t stays() const {
+        size_t count = 0;
+        for (const auto& day : partitionRows) count += day.second.size();
+        return count;
+    }
+
+    long longStayCapacity(int fromDay, int toDay) const {
+        long capacity = 0;
+        for (const auto& type : roomTypes) {
+            capacity += calendar.longStayCapacity(type.second.allRoomNumbers, fromDay, toDay);
+        }
+        return capacity;
+    }
+};
+
+struct StayRequest {
+    int option;
+    int arrival;        // index into the date list
+    int nights;
+};
+
+void runAssignPolicy(const std::string& label, bool bestFit,
+                     const std::vector<StayRequest>& requests,
+                     const std::vector<std::string>& dates, int horizon) {
+    AssignProbe hotel;
+    hotel.setBestFitAssignment(bestFit);
+    int fromDay = Hotel::dateToDayNumber(dates[1]);
+    int toDay = fromDay + horizon;
+
+    Clock::time_point start = Clock::now();
+    {
+        QuietScope quiet;
+        hotel.loadFromFile(dates[0]);
+        for (size_t i = 0; i < requests.size(); ++i) {
+            const StayRequest& r = requests[i];
+            hotel.reserveRoom(r.option, "Guest" + std::to_string(i), dates[r.arrival],
+                              dates[r.arrival], 15, r.nights);
+        }
+    }
+    Clock::duration reserveTime = Clock::now() - start;
+
+    report(label, static_cast<long>(requests.size()), reserveTime);
+    std::cout << "  booked " << hotel.stays() << " stays, long-stay capacity "
+              << hotel.longStayCapacity(fromDay, toDay) << " room-nights\n";
+
+    Hotel::ReoptimizeReport result;
+    start = Clock::now();
+    {
+        QuietScope quiet;
+        result = hotel.reoptimizeAssignments(dates[0]);
+    }
+    Clock::duration reoptimizeTime = Clock::now() - start;
+
+    report(label + "-reopt", static_cast<long>(result.staysConsidered), reoptimizeTime);
+    std::cout << "  moved " << result.staysMoved << " stays, long-stay capacity "
+              << hotel.longStayCapacity(fromDay, toDay) << " room-nights\n";
+}
+
+void runAssign(int requestCount) {
+    const int horizon = 365;
+    const std::vector<std::string> dates = makeDates(horizon + 1, 2026);
+
+    // Mostly one- and two-night stays with a tail of long ones, arriving
+    // anywhere in the next year, requested in random order
+    Lcg rng(7);
+    std::vector<StayRequest> requests;
+    requests.reserve(requestCount);
+    for (int i = 0; i < requestCount; ++i) {
+        StayRequest r;
+        r.option = 1 + static_cast<int>(rng.next(5));
+        r.nights = rng.next(10) < 7 ? 1 + static_cast<int>(rng.next(2))
+                                    : 3 + static_cast<int>(rng.next(8));
+        r.arrival = 1 + static_cast<int>(rng.next(static_cast<unsigned>(horizon - r.nights)));
+        requests.push_back(r);
+    }
+
+    std::cout << "assign: " << requestCount << " stay requests, 500 rooms, "
+              << horizon << "-day horizon\n";
+    runAssignPolicy("first-fit", false, requests, dates, horizon);
+    runAssignPolicy("best-fit", true, requests, dates, horizon);
+}
+
+// Checks one view: the loaded date's rows, the per-type availability and
+// the revenue must all describe the same set of bookings
+bool consistent(const Hotel::Snapshot& view) {
+    const Hotel::Snapshot::DayRows* rows = view.rowsFor(view.loadedDate);
+    size_t booked = 0;
+    double revenue = 0.0;
+    if (rows) {
+        Hotel::Snapshot::RowChunks::forEach(*rows, [&](const Hotel::Reservation& r) {
+            ++booked;
+            revenue += r.totalCost;
+        });
+    }
+
+    size_t occupied = 0;
+    for (const Hotel::Snapshot::TypeAvailability& type : view.roomTypes) {
+        occupied += static_cast<size_t>(type.totalRooms - type.availableRooms);
+    }
+    return booked == occupied && revenue > view.totalRevenue - 0.5 &&
+           revenue < view.totalRevenue + 0.5;
+}
+
+void runSnapshot(int operations) {
+    const std::string today = "06-01-2026";
+    const int batch = 400;   // bookings per round before undoing them all
+
+    // One writer alone first, then the same writer with readers scanning
+    for (unsigned readerCount : { 0u, 3u }) {
+        SyntheticHotel hotel;
+        {
+            QuietScope quiet;
+            hotel.loadFromFile(today);
+        }
+
+        std::atomic<bool> done(false);
+        std::atomic<long> scans(0);
+        std::atomic<long> torn(0);
+        std::vector<std::thread> readers;
+        for (unsigned i = 0; i < readerCount; ++i) {
+            readers.emplace_back([&] {
+                unsigned long long lastVersion = 0;
+                while (!done.load(std::memory_order_relaxed)) {
+                    std::shared_ptr<const Hotel::Snapshot> view = hotel.snapshot();
+                    if (view->version < lastVersion || !consistent(*view)) torn.fetch_add(1);
+                    lastVersion = view->version;
+                    scans.fetch_add(1, std::memory_order_relaxed);
+                }
+            });
+        }
+
+        long writes = 0;
+        Clock::time_point start = Clock::now();
+        {
+            QuietScope quiet;
+            while (writes < operations) {
+                for (int i = 0; i < batch; ++i, ++writes) {
+                    hotel.reserveRoom(1 + i % 5, "Guest" + std::to_string(writes), today, today, 15, 1);
+                }
+                for (int i = 0; i < batch; ++i, ++writes) {
+                    hotel.undoLastBooking();
+                }
+            }
+        }
+        Clock::duration writeTime = Clock::now() - start;
+        done = true;
+        for (std::thread& reader : readers) reader.join();
+
+        std::string label = "write+" + std::to_string(readerCount) + "r";
+        report(label, writes, writeTime);
+        if (readerCount > 0) {
+            report("snapshot-scan", scans.load(), writeTime);
+            std::cout << "  " << torn.load() << " inconsistent views\n";
+        }
+    }
+}
+
+// "VmRSS" / "VmHWM" from /proc/self/status in KiB (0 where unavailable)
+long procStatusKiB(const std::string& field) {
+    std::ifstream status("/proc/self/status");
+    std::string line;
+    while (std::getline(status, line)) {
+        if (line.compare(0, field.size() + 1, field + ":") == 0) {
+            return std::atol(line.c_str() + field.size() + 1);
+        }
+    }
+    return 0;
+}
+
+void runMemory(int stays) {
+    const int years = 10;
+    const std::vector<std::string> dates = makeDates(years * 365, 2026);
+    const int steps = 10;
+
+    SyntheticHotel hotel;
+    {
+        QuietScope quiet;
+        hotel.loadFromFile(dates[0]);
+    }
+
+    std::cout << "memory: " << stays << " stays over " << years << " years, 500 rooms\n";
+    std::cout << std::right << std::setw(10) << "stays" << std::setw(14) << "tracked KiB"
+              << std::setw(12) << "peak KiB" << std::setw(10) << "B/stay"
+              << std::setw(10) << "RSS KiB" << std::setw(10) << "HWM KiB" << "\n";
+
+    Lcg rng(11);
+    long booked = 0;
+    Clock::duration reserveTime{};
+    for (int step = 1; step <= steps; ++step) {
+        long target = static_cast<long>(stays) * step / steps;
+        Clock::time_point start = Clock::now();
+        {
+            QuietScope quiet;
+            for (; booked < target; ++booked) {
+                const std::string& date = dates[1 + rng.next(static_cast<unsigned>(dates.size() - 1))];
+                hotel.reserveRoom(1 + static_cast<int>(rng.next(5)), "Guest" + std::to_string(booked),
+                                  date, date, 15, 1);
+            }
+        }
+        reserveTime += Clock::now() - start;
+
+        Hotel::MemoryReport report = hotel.memoryReport();
+        std::cout << std::setw(10) << booked
+                  << std::setw(14) << report.totalBytes / 1024
+                  << std::setw(12) << report.peakContainerBytes / 1024
+                  << std::setw(10) << (booked > 0 ? report.totalBytes / booked : 0)
+                  << std::setw(10) << procStatusKiB("VmRSS")
+                  << std::setw(10) << procStatusKiB("VmHWM") << "\n";
+    }
+    report("reserve", booked, reserveTime);
+
+    // Where the bytes are at the end, largest first
+    Hotel::MemoryReport final = hotel.memoryReport();
+    std::sort(final.structures.begin(), final.structures.end(),
+              [](const Hotel::MemoryUsage& a, const Hotel::MemoryUsage& b) {
+                  return a.bytes + a.stringBytes > b.bytes + b.stringBytes;
+              });
+    for (const Hotel::MemoryUsage& usage : final.structures) {
+        std::cout << "  " << std::left << std::setw(20) << usage.structure << std::right
+                  << std::setw(10) << (usage.bytes + usage.stringBytes) / 1024 << " KiB"
+                  << std::setw(10) << usage.elements << " elements\n";
+    }
+}
+
+// What the data team does today: read every day file and pick out the rows
+// for a date range (legacy two-column rows take the file's date, no cost)
+void scrapeDayFiles(const fs::path& directory, int fromDay, int toDay,
+                    long& rows, double& revenue) {
+    rows = 0;
+    revenue = 0.0;
+    std::string line;
+    for (const fs::directory_entry& entry : fs::directory_iterator(directory)) {
+        std::ifstream in(entry.path());
+        std::getline(in, line);                                  // revenue preamble
+        int fileDay = Hotel::dateToDayNumber(entry.path().stem().string());
+        while (std::getline(in, line)) {
+            std::vector<std::string> fields;
+            size_t pos = 0;
+            for (size_t next; (next = line.find(',', pos)) != std::string::npos; pos = next + 1) {
+                fields.push_back(line.substr(pos, next - pos));
+            }
+            fields.push_back(line.substr(pos));
+            if (fields.size() >= 8 && fields[0] == "GuestName") continue;
+            int day = fields.size() >= 8 ? Hotel::dateToDayNumber(fields[3]) : fileDay;
+            if (day < fromDay || day > toDay) continue;
+            ++rows;
+            if (fields.size() >= 8) revenue += std::atof(fields[7].c_str());
+        }
+    }
+}
+
+uintmax_t directoryBytes(const fs::path& directory) {
+    uintmax_t bytes = 0;
+    for (const fs::directory_entry& entry : fs::directory_iterator(directory)) {
+        bytes += entry.file_size();
+    }
+    return bytes;
+}
+
+void runExport(int years) {
+    const fs::path historyDir = writeHistory(years, "export_history");
+    std::cout << "export: " << years << " years of day files, "
+              << directoryBytes(historyDir) / 1024 << " KiB as CSV\n";
+
+    // Day files -> columnar, one file at a time
+    Hotel::ExportReport fromFiles = Hotel::exportDirectoryColumnar(historyDir.string(), "history.hcol");
+    if (!fromFiles.ok) {
+        std::cout << "  export failed: " << fromFiles.error << "\n";
+        return;
+    }
+    std::cout << "  " << fromFiles.rows << " rows, " << fromFiles.rowGroups << " row groups, "
+              << fromFiles.bytes / 1024 << " KiB columnar\n";
+    report("export-files", static_cast<long>(fromFiles.rows),
+           std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double, std::milli>(fromFiles.millis)));
+
+    // Live store -> columnar, from a snapshot
+    SyntheticHotel hotel;
+    {
+        QuietScope quiet;
+        hotel.importDirectory(historyDir.string());
+    }
+    Hotel::ExportReport fromStore = hotel.exportColumnar("store.hcol");
+    report("export-store", static_cast<long>(fromStore.rows),
+           std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double, std::milli>(fromStore.millis)));
+
+    // Full history and one month: CSV scrape vs columnar scan
+    const int firstDay = Hotel::dateToDayNumber("01-01-2020");
+    const int lastDay = firstDay + years * 365;
+    const int monthFrom = Hotel::dateToDayNumber("06-01-2021");
+    const int monthTo = Hotel::dateToDayNumber("06-30-2021");
+    struct Query { const char* label; int from; int to; };
+    for (const Query& query : { Query{ "all", firstDay, lastDay }, Query{ "month", monthFrom, monthTo } }) {
+        long csvRows = 0;
+        double csvRevenue = 0.0;
+        Clock::time_point start = Clock::now();
+        scrapeDayFiles(historyDir, query.from, query.to, csvRows, csvRevenue);
+        Clock::duration csvTime = Clock::now() - start;
+
+        ColumnarReader reader("history.hcol");
+        long visited = 0;
+        start = Clock::now();
+        ColumnarReader::ScanStats scan = reader.scan(query.from, query.to,
+                                                     [&visited](const Hotel::Reservation&) { ++visited; });
+        Clock::duration scanTime = Clock::now() - start;
+
+        start = Clock::now();
+        ColumnarReader::ScanStats sum = reader.revenue(query.from, query.to);
+        Clock::duration sumTime = Clock::now() - start;
+
+        std::cout << "  " << query.label << ": " << csvRows << " rows, CSV revenue "
+                  << std::fixed << std::setprecision(0) << csvRevenue << ", columnar "
+                  << scan.revenue << " / " << sum.revenue << "; scan read "
+                  << scan.groupsRead << " of " << reader.rowGroups().size() << " row groups\n";
+        if (static_cast<long>(scan.rowsMatched) != csvRows || visited != csvRows) {
+            std::cout << "  MISMATCH: columnar matched " << scan.rowsMatched << " rows\n";
+        }
+        report(std::string("csv-") + query.label, csvRows, csvTime);
+        report(std::string("scan-") + query.label, static_cast<long>(scan.rowsMatched), scanTime);
+        report(std::string("sum-") + query.label, static_cast<long>(sum.rowsMatched), sumTime);
+    }
+}
+
+void runForecast(int years) {
+    const fs::path historyDir = writeHistory(years, "forecast_history");
+    const std::vector<std::string> dates = makeDates(years * 365, 2020);
+
+    // As of 120 days before the end of the history, so every night of the
+    // horizon has its final bookings on file to check the projection against
+    const std::string asOf = dates[dates.size() - 120];
+    SyntheticHotel hotel;
+    {
+        QuietScope quiet;
+        hotel.loadFromFile(asOf);
+        hotel.importDirectory(historyDir.string());
+    }
+
+    Clock::time_point start = Clock::now();
+    const BookingForecaster::Forecast* forecast = hotel.forecast();
+    Clock::duration buildTime = Clock::now() - start;
+    if (!forecast) return;
+
+    // Final room-nights per type and night, from every stored row
+    const int horizon = BookingForecaster::horizonDays;
+    std::vector<double> actual(forecast->types.size() * horizon, 0.0);
+    std::shared_ptr<const Hotel::Snapshot> view = hotel.snapshot();
+    for (const auto& month : *view->days) {
+        for (const auto& day : *month.second) {
+            Hotel::Snapshot::RowChunks::forEach(*day.second, [&](const Hotel::Reservation& r) {
+                int arrival = Hotel::dateToDayNumber(r.stayDate);
+                for (size_t t = 0; t < forecast->types.size(); ++t) {
+                    if (forecast->types[t].name != r.roomType) continue;
+                    for (int n = 0; n < std::max(r.nights, 1); ++n) {
+                        int k = arrival + n - forecast->asOfDay;
+                        if (k >= 0 && k < horizon) actual[t * horizon + k] += 1.0;
+                    }
+                }
+            });
+        }
+    }
+    double projectedError = 0.0, onBooksError = 0.0, actualNights = 0.0;
+    for (size_t t = 0; t < forecast->types.size(); ++t) {
+        for (int k = 0; k < horizon; ++k) {
+            double final = actual[t * horizon + k];
+            projectedError += std::abs(forecast->types[t].projected[k] - final);
+            onBooksError += std::abs(forecast->types[t].onBooks[k] - final);
+            actualNights += final;
+        }
+    }
+
+    std::cout << "forecast: as of " << asOf << " over " << years << " years of history, "
+              << forecast->types.size() << " room types x " << horizon << " nights\n";
+    std::cout << "  absolute error vs final room-nights: projected "
+              << std::fixed << std::setprecision(1) << 100.0 * projectedError / actualNights
+              << "%, on the books only " << 100.0 * onBooksError / actualNights << "%\n";
+    report("forecast-build", 1, buildTime);
+
+    // The same forecast with the history attached as the CLI does, not imported
+    {
+        const double importedRevenue = forecast->totalRevenue;
+        fs::current_path(historyDir);
+        double attachedRevenue = 0.0;
+        {
+            SyntheticHotel attached;
+            QuietScope quiet;
+            attached.attachHistory(".");
+            attached.loadFromFile(asOf);
+            start = Clock::now();
+            attachedRevenue = attached.forecast()->totalRevenue;
+            buildTime = Clock::now() - start;
+        }
+        fs::current_path(historyDir.parent_path());
+        report("forecast-attached", 1, buildTime);
+        // The import rejects the history's two double bookings; read from
+        // file they still count
+        if (std::abs(attachedRevenue - importedRevenue) > 1e-4 * std::abs(importedRevenue)) {
+            std::cout << "  ** MISMATCH ** attached $" << attachedRevenue
+                      << " vs imported $" << importedRevenue << "\n";
+        }
+    }
+
+    // Full projection over every type and night, history unchanged
+    const int rounds = 10000;
+    start = Clock::now();
+    double checksum = 0.0;
+    for (int i = 0; i < rounds; ++i) {
+        checksum += hotel.forecast()->totalRevenue;
+    }
+    report("forecast-batch", rounds, Clock::now() - start);
+
+    // Booking, then refreshing the forecast, as the menu would
+    const int bookings = 2000;
+    Lcg rng(5);
+    start = Clock::now();
+    {
+        QuietScope quiet;
+        for (int i = 0; i < bookings; ++i) {
+            const std::string& date = dates[dates.size() - 120 + rng.next(90)];
+            hotel.reserveRoom(1 + static_cast<int>(rng.next(5)), "Pace" + std::to_string(i),
+                              date, date, 15, 1 + static_cast<int>(rng.next(3)));
+            checksum += hotel.forecast()->totalRevenue;
+        }
+    }
+    report("reserve+refresh", bookings, Clock::now() - start);
+    if (checksum == 0.0) std::cout << "(no revenue)\n";
+}
+
+#ifdef HOTEL_HAVE_SHARDS
+// One coordinator over `shardCount` shards; bookings are spread evenly
+void runShardLayout(const std::string& label, std::vector<ShardSpec> specs,
+                    const std::vector<ShardCoordinator::Booking>& bookings) {
+    for (ShardSpec& spec : specs) {
+        spec.makeHotel = []() { return std::unique_ptr<Hotel>(new SyntheticHotel); };
+    }
+    ShardCoordinator coordinator(specs);
+    if (!coordinator.ok()) {
+        std::cout << "  " << label << ": " << coordinator.lastError() << "\n";
+        return;
+    }
+
+    Clock::time_point start = Clock::now();
+    std::vector<ShardCoordinator::BookingResult> results = coordinator.reserveBatch(bookings);
+    Clock::duration batchTime = Clock::now() - start;
+
+    long booked = 0, crossing = 0;
+    double bookedRevenue = 0.0;
+    for (const ShardCoordinator::BookingResult& result : results) {
+        if (result.ok) {
+            ++booked;
+            bookedRevenue += result.totalCost;
+        } else if (result.error.find("past the last day") != std::string::npos) {
+            ++crossing;
+        }
+    }
+
+    // One request at a time, waiting for each reply
+    const size_t single = std::min<size_t>(2000, bookings.size());
+    start = Clock::now();
+    for (size_t i = 0; i < single; ++i) {
+        ShardCoordinator::Booking booking = bookings[i];
+        booking.guestName += "-again";
+        ShardCoordinator::BookingResult result = coordinator.reserve(booking);
+        if (result.ok) bookedRevenue += result.totalCost;
+    }
+    Clock::duration singleTime = Clock::now() - start;
+
+    const int queries = 200;
+    ShardCoordinator::RevenueReport revenue;
+    start = Clock::now();
+    for (int i = 0; i < queries; ++i) {
+        revenue = coordinator.portfolioRevenue(0, 1 << 30);
+    }
+    Clock::duration queryTime = Clock::now() - start;
+
+    std::cout << "  " << label << ": " << coordinator.shardCount() << " shards, " << booked
+              << " of " << bookings.size() << " booked";
+    if (crossing > 0) std::cout << " (" << crossing << " crossed a shard boundary)";
+    std::cout << ", portfolio revenue " << std::fixed << std::setprecision(0) << revenue.revenue
+              << (std::abs(revenue.revenue - bookedRevenue) < 0.5 ? " (matches)" : " (MISMATCH)") << "\n";
+    report(label + "-batch", static_cast<long>(bookings.size()), batchTime);
+    report(label + "-single", static_cast<long>(single), singleTime);
+    report(label + "-revenue", queries, queryTime);
+}
+
+void runShards(int bookings) {
+    const std::vector<std::string> dates = makeDates(365, 2026);
+    const int firstDay = Hotel::dateToDayNumber(dates[0]);
+    std::cout << "shards: " << bookings << " bookings through a coordinator, "
+              << std::thread::hardware_concurrency() << " hardware threads\n";
+
+    for (int shardCount : { 1, 2, 4 }) {
+        std::vector<ShardSpec> specs;
+        for (int s = 0; s < shardCount; ++s) {
+            ShardSpec spec;
+            spec.property = "S" + std::to_string(s + 1);
+            spec.directory = "shards" + std::to_string(shardCount) + "/" + spec.property;
+            spec.loadedDate = dates[0];
+            specs.push_back(spec);
+        }
+        Lcg rng(17);
+        std::vector<ShardCoordinator::Booking> batch;
+        for (int i = 0; i < bookings; ++i) {
+            batch.push_back({ specs[rng.next(static_cast<unsigned>(shardCount))].property,
+                              1 + static_cast<int>(rng.next(5)), "Guest" + std::to_string(i),
+                              dates[1 + rng.next(static_cast<unsigned>(dates.size() - 1))],
+                              1 + static_cast<int>(rng.next(3)), 15 });
+        }
+        runShardLayout("property" + std::to_string(shardCount), specs, batch);
+    }
+
+    // One property, arrivals split into four quarters
+    std::vector<ShardSpec> specs;
+    for (int q = 0; q < 4; ++q) {
+        ShardSpec spec;
+        spec.property = "S1";
+        spec.directory = "shards-dates/Q" + std::to_string(q + 1);
+        spec.loadedDate = dates[0];
+        spec.fromDay = q == 0 ? -1 : firstDay + q * 91;
+        spec.toDay = q == 3 ? -1 : firstDay + (q + 1) * 91 - 1;
+        specs.push_back(spec);
+    }
+    Lcg rng(17);
+    std::vector<ShardCoordinator::Booking> batch;
+    for (int i = 0; i < bookings; ++i) {
+        batch.push_back({ "S1", 1 + static_cast<int>(rng.next(5)), "Guest" + std::to_string(i),
+                          dates[1 + rng.next(static_cast<unsigned>(dates.size() - 1))],
+                          1 + static_cast<int>(rng.next(3)), 15 });
+    }
+    runShardLayout("dates4", specs, batch);
+}
+#endif
+
+// Start-up with years of history: import everything vs. attach the files
+// and page dates in as they are queried
+void runLazy(int years) {
+    const fs::path historyDir = writeHistory(years, "lazy_history");
+    const std::vector<std::string> dates = makeDates(years * 365, 2020);
+    const std::string& today = dates.back();
+    std::cout << "lazy: " << dates.size() << " day files, "
+              << directoryBytes(historyDir) / (1024 * 1024) << " MiB\n";
+
+    // Ready = constructed, history available, first booking taken
+    for (bool lazy : { false, true }) {
+        Clock::time_point start = Clock::now();
+        SyntheticHotel hotel;
+        {
+            QuietScope quiet;
+            if (lazy) {
+                hotel.attachHistory(historyDir.string());
+            } else {
+                hotel.importDirectory(historyDir.string());
+            }
+            hotel.reserveRoom(1, "First", today, today, 15, 1);
+        }
+        report(lazy ? "lazy-ready" : "import-ready", 1, Clock::now() - start);
+    }
+
+    // Day queries, 80% within the last 60 days, under an 8 MiB budget
+    SyntheticHotel hotel;
+    hotel.attachHistory(historyDir.string(), 8u << 20);
+    HistoryStore& store = *hotel.historyStore();
+    const int queries = 20000;
+    Lcg rng(23);
+    size_t rows = 0;
+    Clock::time_point start = Clock::now();
+    for (int i = 0; i < queries; ++i) {
+        size_t back = rng.next(5) != 0 ? rng.next(60) : rng.next(static_cast<unsigned>(dates.size()));
+        std::shared_ptr<const HistoryStore::DayPage> page = store.day(dates[dates.size() - 1 - back]);
+        if (page) rows += page->rows.size();
+    }
+    Clock::duration queryTime = Clock::now() - start;
+    HistoryStore::Stats stats = store.stats();
+    report("day-query", queries, queryTime);
+    std::cout << "  " << stats.dayHits << " hits, " << stats.dayMisses << " reads, "
+              << stats.evictions << " evictions, " << stats.residentEntries << " pages resident ("
+              << stats.residentBytes / 1024 << " KiB of " << store.budget() / 1024 << " KiB)\n";
+
+    // Guest lookups at the default budget: the first builds the month
+    // indexes, later ones reuse them
+    store.setBudget(HistoryStore::defaultBudget);
+    const size_t evictionsBefore = store.stats().evictions;
+    start = Clock::now();
+    size_t stays = store.findGuest("G12345").size();
+    report("guest-cold", 1, Clock::now() - start);
+    const int lookups = 200;
+    start = Clock::now();
+    for (int i = 0; i < lookups; ++i) {
+        stays += store.findGuest("G" + std::to_string(rng.next(200000))).size();
+    }
+    report("guest-warm", lookups, Clock::now() - start);
+    stats = store.stats();
+    std::cout << "  " << stats.monthIndexesBuilt << " month indexes, "
+              << stats.residentBytes / (1024 * 1024) << " MiB resident, "
+              << stats.evictions - evictionsBefore << " evictions\n";
+    if (rows == 0 || stays == 0) std::cout << "(no history found)\n";
+}
+
+// Record `operations` loads, bookings, undos and saves over 60 days of
+// synthetic history (the day files travel in the trace), then replay it
+void runReplay(int operations) {
+    const std::vector<std::string> dates = makeDates(60, 2020);
+    const fs::path recordDir = writeHistory(1, "replay_record");
+    const fs::path tracePath = fs::current_path() / "replay.trace";
+    const int perDay = std::max(1, operations / static_cast<int>(dates.size()));
+
+    Clock::time_point start = Clock::now();
+    size_t recorded = 0;
+    {
+        fs::current_path(recordDir);
+        SyntheticHotel hotel;
+        TraceRecorder recorder(hotel, "synthetic", tracePath.string());
+        QuietScope quiet;
+        Lcg rng(11);
+        for (size_t d = 0; d < dates.size() && recorder.operations() < static_cast<size_t>(operations); ++d) {
+            recorder.loadFromFile(dates[d]);
+            for (int i = 0; i < perDay; ++i) {
+                if (i % 10 == 9) {
+                    recorder.undoLastBooking();
+                    continue;
+                }
+                const std::string& date = dates[std::min(dates.size() - 1, d + rng.next(30))];
+                recorder.reserveRoom(1 + static_cast<int>(rng.next(5)), "Trace" + std::to_string(d * perDay + i),
+                                     date, date, 12 + static_cast<int>(rng.next(10)),
+                                     1 + static_cast<int>(rng.next(4)));
+            }
+            recorder.saveToFile(dates[d]);
+        }
+        recorder.finish();
+        recorded = recorder.operations();
+        fs::current_path(recordDir.parent_path());
+    }
+    Clock::duration recordTime = Clock::now() - start;
+
+    TraceReplayer replayer(tracePath.string());
+    HotelFactory factory = [](const std::string& layout) {
+        return layout == "synthetic" ? std::unique_ptr<Hotel>(new SyntheticHotel) : makeLayoutHotel(layout);
+    };
+    std::cout << "replay: " << recorded << " operations over " << dates.size() << " days, trace "
+              << fs::file_size(tracePath) / 1024 << " KiB\n";
+    report("record", static_cast<long>(recorded), recordTime);
+    for (int run = 1; run <= 3; ++run) {
+        ReplayReport result = replayer.run(factory);
+        if (!result.error.empty()) {
+            std::cout << "  replay failed: " << result.error << "\n";
+            return;
+        }
+        report("replay" + std::to_string(run), static_cast<long>(result.operations),
+               std::chrono::duration_cast<Clock::duration>(
+                   std::chrono::duration<double, std::milli>(result.millis)));
+        std::cout << "  " << result.checks << " checks, "
+                  << (result.passed() ? "identical" : std::to_string(result.mismatches) + " MISMATCHES") << "\n";
+        for (const std::string& m : result.firstMismatches) std::cout << "    " << m << "\n";
+    }
+}
+
+template <class HotelType>
+void runCatalogFlavour(const std::string& label, int hotels) {
+    Clock::time_point start = Clock::now();
+    for (int i = 0; i < hotels; ++i) {
+        CatalogProbe<HotelType> hotel;
+    }
+    Clock::duration buildTime = Clock::now() - start;
+
+    CatalogProbe<HotelType> hotel;
+    double checksum = 0.0;
+    const int rounds = hotels * 5;
+    start = Clock::now();
+    for (int i = 0; i < rounds; ++i) {
+        checksum += hotel.lookupAll(100, 310);
+    }
+    Clock::duration lookupTime = Clock::now() - start;
+
+    report(label + "-build", hotels, buildTime);
+    report(label + "-find", static_cast<long>(rounds) * 211, lookupTime);
+    if (checksum == 0.0) std::cout << "(empty catalog)\n";
+}
+
+void runCatalog(int hotels) {
+    std::cout << "catalog: " << hotels << " Hilton catalogs\n";
+    runCatalogFlavour<HiltonHotel>("fixed", hotels);
+    runCatalogFlavour<RuntimeHiltonHotel>("runtime", hotels);
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    std::string workload = argc > 1 ? argv[1] : "all";
+    int size = argc > 2 ? std::atoi(argv[2]) : 0;
+    if ((workload != "all" && workload != "days" && workload != "import" &&
+         workload != "catalog" && workload != "assign" && workload != "snapshot" &&
+         workload != "memory" && workload != "export" && workload != "forecast" &&
+         workload != "shards" && workload != "replay" && workload != "lazy") ||
+        (argc > 2 && size <= 0)) {
+        std::cerr << "Usage: " << argv[0] << " [all|days|import|catalog|assign|snapshot|memory|export|forecast|shards|lazy|replay] [size]\n";
+        return 1;
+    }
+
+    // Work in a scratch directory so <date>.txt files never land in the repo
+    fs::path originalDir = fs::current_path();
+    fs::path scratch = fs::temp_directory_path() / "hotel_bench";
+    fs::remove_all(scratch);
+    fs::create_directories(scratch);
+    fs::current_path(scratch);
+
+    if (workload == "all" || workload == "days") {
+        runDays(size > 0 && workload == "days" ? size : 365);
+    }
+    if (workload == "all" || workload == "import") {
+        runImport(size > 0 && workload == "import" ? size : 5);
+    }
+    if (workload == "all" || workload == "catalog") {
+        runCatalog(size > 0 && workload == "catalog" ? size : 20000);
+    }
+    if (workload == "all" || workload == "assign") {
+        runAssign(size > 0 && workload == "assign" ? size : 40000);
+    }
+    if (workload == "all" || workload == "snapshot") {
+        std::cout << "snapshot: one writer, readers scanning snapshots\n";
+        runSnapshot(size > 0 && workload == "snapshot" ? size : 200000);
+    }
+    if (workload == "all" || workload == "memory") {
+        runMemory(size > 0 && workload == "memory" ? size : 200000);
+    }
+    if (workload == "all" || workload == "export") {
+        runExport(size > 0 && workload == "export" ? size : 5);
+    }
+    if (workload == "all" || workload == "forecast") {
+        runForecast(size > 0 && workload == "forecast" ? size : 2);
+    }
+#ifdef HOTEL_HAVE_SHARDS
+    if (workload == "all" || workload == "shards") {
+        runShards(size > 0 && workload == "shards" ? size : 20000);
+    }
+#endif
+    if (workload == "all" || workload == "lazy") {
+        runLazy(size > 0 && workload == "lazy" ? size : 5);
+    }
+    if (workload == "all" || workload == "replay") {
+        runReplay(size > 0 && workload == "replay" ? size : 20000);
+    }
+
+    fs::current_path(originalDir);
+    fs::remove_all(scratch);
+    return 0;
+}
@@ -0,0 +1,552 @@
+#include "columnar.h"
+
+#include <cstring>
+#include <filesystem>
+
+using namespace std;
+
+namespace {
+
+const char fileMagic[4] = { 'H', 'C', 'O', 'L' };
+const char footerMagic[8] = { 'H', 'C', 'O', 'L', 'E', 'N', 'D', '\0' };
+const uint32_t formatVersion = 1;
+const size_t headerSize = sizeof(fileMagic) + 4;
+const size_t trailerSize = 8 + sizeof(footerMagic);
+
+// Columns in the order they are written in a row group
+enum Column { GuestColumn, RoomTypeColumn, DateColumnIndex, RoomColumn, NightsColumn,
+              HourColumn, PriceColumn, CostColumn, BookedColumn, ColumnCount };
+
+// Row count plus the column offset table
+const size_t groupHeaderSize = 4 + 4 * ColumnCount;
+
+// ----- Little-endian encoding -----
+
+void putU8(string& out, uint8_t v) {
+    out.push_back(static_cast<char>(v));
+}
+
+void putU32(string& out, uint32_t v) {
+    for (int i = 0; i < 4; ++i) out.push_back(static_cast<char>((v >> (8 * i)) & 0xff));
+}
+
+void putU64(string& out, uint64_t v) {
+    for (int i = 0; i < 8; ++i) out.push_back(static_cast<char>((v >> (8 * i)) & 0xff));
+}
+
+void putI32(string& out, int32_t v) {
+    putU32(out, static_cast<uint32_t>(v));
+}
+
+void putF64(string& out, double v) {
+    uint64_t bits;
+    std::memcpy(&bits, &v, sizeof(bits));
+    putU64(out, bits);
+}
+
+void putText(string& out, const string& text) {
+    putU32(out, static_cast<uint32_t>(text.size()));
+    out.append(text);
+}
+
+void setU32(string& out, size_t at, uint32_t v) {
+    for (int i = 0; i < 4; ++i) out[at + i] = static_cast<char>((v >> (8 * i)) & 0xff);
+}
+
+uint32_t getU32(const char* p) {
+    uint32_t v = 0;
+    for (int i = 0; i < 4; ++i) v |= static_cast<uint32_t>(static_cast<unsigned char>(p[i])) << (8 * i);
+    return v;
+}
+
+uint64_t getU64(const char* p) {
+    uint64_t v = 0;
+    for (int i = 0; i < 8; ++i) v |= static_cast<uint64_t>(static_cast<unsigned char>(p[i])) << (8 * i);
+    return v;
+}
+
+int32_t getI32(const char* p) {
+    return static_cast<int32_t>(getU32(p));
+}
+
+double getF64(const char* p) {
+    uint64_t bits = getU64(p);
+    double v;
+    std::memcpy(&v, &bits, sizeof(v));
+    return v;
+}
+
+// Bytes per dictionary code
+uint8_t codeWidth(size_t dictionarySize) {
+    if (dictionarySize <= 0x100) return 1;
+    if (dictionarySize <= 0x10000) return 2;
+    return 4;
+}
+
+void putCodes(string& out, const vector<uint32_t>& codes, size_t dictionarySize) {
+    uint8_t width = codeWidth(dictionarySize);
+    putU8(out, width);
+    for (uint32_t code : codes) {
+        for (int i = 0; i < width; ++i) out.push_back(static_cast<char>((code >> (8 * i)) & 0xff));
+    }
+}
+
+// Bounds-checked reader over one row group
+struct Cursor {
+    const char* p;
+    const char* end;
+    bool ok = true;
+
+    Cursor(const char* begin, const char* end) : p(begin), end(end) {}
+
+    const char* take(size_t n) {
+        if (!ok || static_cast<size_t>(end - p) < n) {
+            ok = false;
+            return nullptr;
+        }
+        const char* at = p;
+        p += n;
+        return at;
+    }
+
+    uint8_t u8() { const char* at = take(1); return at ? static_cast<uint8_t>(*at) : 0; }
+    uint32_t u32() { const char* at = take(4); return at ? getU32(at) : 0; }
+    int32_t i32() { const char* at = take(4); return at ? getI32(at) : 0; }
+
+    string text() {
+        uint32_t size = u32();
+        const char* at = take(size);
+        return at ? string(at, size) : string();
+    }
+};
+
+// Dictionary codes of one column: `width` bytes per row starting at `data`
+struct Codes {
+    const char* data = nullptr;
+    uint8_t width = 0;
+
+    uint32_t operator[](size_t row) const {
+        const char* at = data + row * width;
+        uint32_t code = 0;
+        for (int i = 0; i < width; ++i) code |= static_cast<uint32_t>(static_cast<unsigned char>(at[i])) << (8 * i);
+        return code;
+    }
+};
+
+bool readCodes(Cursor& in, uint32_t rows, Codes& codes) {
+    codes.width = in.u8();
+    if (codes.width != 1 && codes.width != 2 && codes.width != 4) return false;
+    codes.data = in.take(static_cast<size_t>(rows) * codes.width);
+    return in.ok;
+}
+
+bool readStringColumn(Cursor& in, uint32_t rows, vector<string>& dictionary, Codes& codes) {
+    uint32_t size = in.u32();
+    if (!in.ok || size > static_cast<size_t>(in.end - in.p) / 4) return false;
+    dictionary.clear();
+    dictionary.reserve(size);
+    for (uint32_t i = 0; i < size && in.ok; ++i) dictionary.push_back(in.text());
+    return in.ok && readCodes(in, rows, codes);
+}
+
+} // namespace
+
+// ---------------- ColumnarWriter ----------------
+
+void ColumnarWriter::StringColumn::add(const string& value) {
+    auto inserted = codes.emplace(value, static_cast<uint32_t>(values.size()));
+    if (inserted.second) values.push_back(&inserted.first->first);
+    rows.push_back(inserted.first->second);
+}
+
+void ColumnarWriter::StringColumn::clear() {
+    codes.clear();
+    values.clear();
+    rows.clear();
+}
+
+int32_t ColumnarWriter::DateColumn::add(const string& date) {
+    auto inserted = codes.emplace(date, static_cast<uint32_t>(values.size()));
+    if (inserted.second) {
+        values.push_back(&inserted.first->first);
+        days.push_back(Hotel::dateToDayNumber(date));
+    }
+    rows.push_back(inserted.first->second);
+    return days[inserted.first->second];
+}
+
+void ColumnarWriter::DateColumn::clear() {
+    codes.clear();
+    days.clear();
+    values.clear();
+    rows.clear();
+}
+
+ColumnarWriter::ColumnarWriter(const string& path, size_t rowGroupRows)
+    : path(path),
+      tmpPath(path + ".tmp"),
+      rowGroupRows(rowGroupRows == 0 ? 1 : rowGroupRows) {
+    out.open(tmpPath, std::ios::binary | std::ios::trunc);
+    if (!out.is_open()) {
+        error = "cannot create " + tmpPath;
+        return;
+    }
+    string header(fileMagic, sizeof(fileMagic));
+    putU32(header, formatVersion);
+    write(header);
+}
+
+ColumnarWriter::~ColumnarWriter() {
+    if (!closed) {
+        // Never completed: do not leave a file without a footer behind
+        out.close();
+        std::error_code ec;
+        std::filesystem::remove(tmpPath, ec);
+    }
+}
+
+void ColumnarWriter::write(const string& bytes) {
+    if (!ok()) return;
+    out.write(bytes.data(), static_cast<std::streamsize>(bytes.size()));
+    if (!out) {
+        error = "write to " + tmpPath + " failed";
+        return;
+    }
+    offset += bytes.size();
+}
+
+void ColumnarWriter::append(const Hotel::Reservation& r) {
+    if (!ok() || closed) return;
+
+    int32_t day = dates.add(r.stayDate);
+    if (rooms.empty()) {
+        current.minDay = current.maxDay = day;
+        current.minRoom = current.maxRoom = r.roomNumber;
+    } else {
+        current.minDay = std::min(current.minDay, day);
+        current.maxDay = std::max(current.maxDay, day);
+        current.minRoom = std::min(current.minRoom, static_cast<int32_t>(r.roomNumber));
+        current.maxRoom = std::max(current.maxRoom, static_cast<int32_t>(r.roomNumber));
+    }
+    current.revenue += r.totalCost;
+
+    guests.add(r.guestName);
+    roomTypes.add(r.roomType);
+    rooms.push_back(r.roomNumber);
+    nights.push_back(r.nights);
+    checkInHours.push_back(r.checkInHour);
+    prices.push_back(r.pricePerNight);
+    costs.push_back(r.totalCost);
+    bookedDays.push_back(r.bookedDay);
+    ++totalRows;
+
+    if (rooms.size() >= rowGroupRows) flushGroup();
+}
+
+void ColumnarWriter::flushGroup() {
+    if (rooms.empty()) return;
+
+    uint32_t rows = static_cast<uint32_t>(rooms.size());
+    buffer.clear();
+    putU32(buffer, rows);
+    buffer.append(4 * ColumnCount, '\0');             // column offsets, filled in below
+    auto mark = [this](Column column) {
+        setU32(buffer, 4 + 4 * column, static_cast<uint32_t>(buffer.size()));
+    };
+
+    mark(GuestColumn);
+    putU32(buffer, static_cast<uint32_t>(guests.values.size()));
+    for (const string* value : guests.values) putText(buffer, *value);
+    putCodes(buffer, guests.rows, guests.values.size());
+
+    mark(RoomTypeColumn);
+    putU32(buffer, static_cast<uint32_t>(roomTypes.values.size()));
+    for (const string* value : roomTypes.values) putText(buffer, *value);
+    putCodes(buffer, roomTypes.rows, roomTypes.values.size());
+
+    // Valid dates are rebuilt from their day number; others keep their text
+    mark(DateColumnIndex);
+    putU32(buffer, static_cast<uint32_t>(dates.values.size()));
+    for (size_t i = 0; i < dates.values.size(); ++i) {
+        putI32(buffer, dates.days[i]);
+        if (dates.days[i] < 0) putText(buffer, *dates.values[i]);
+    }
+    putCodes(buffer, dates.rows, dates.values.size());
+
+    mark(RoomColumn);
+    for (int32_t v : rooms) putI32(buffer, v);
+    mark(NightsColumn);
+    for (int32_t v : nights) putI32(buffer, v);
+    mark(HourColumn);
+    for (int32_t v : checkInHours) putI32(buffer, v);
+    mark(PriceColumn);
+    for (double v : prices) putF64(buffer, v);
+    mark(CostColumn);
+    for (double v : costs) putF64(buffer, v);
+    mark(BookedColumn);
+    for (int32_t v : bookedDays) putI32(buffer, v);
+
+    current.offset = offset;
+    current.size = buffer.size();
+    current.rows = rows;
+    write(buffer);
+    groups.push_back(current);
+
+    guests.clear();
+    roomTypes.clear();
+    dates.clear();
+    rooms.clear();
+    nights.clear();
+    checkInHours.clear();
+    prices.clear();
+    costs.clear();
+    bookedDays.clear();
+    current = RowGroupInfo();
+}
+
+bool ColumnarWriter::close() {
+    if (closed) return ok();
+    flushGroup();
+
+    string footer;
+    putU32(footer, static_cast<uint32_t>(groups.size()));
+    for (const RowGroupInfo& group : groups) {
+        putU64(footer, group.offset);
+        putU64(footer, group.size);
+        putU32(footer, group.rows);
+        putI32(footer, group.minDay);
+        putI32(footer, group.maxDay);
+        putI32(footer, group.minRoom);
+        putI32(footer, group.maxRoom);
+        putF64(footer, group.revenue);
+    }
+    putU64(footer, offset);
+    footer.append(footerMagic, sizeof(footerMagic));
+    write(footer);
+
+    out.close();
+    closed = true;
+    std::error_code ec;
+    if (ok() && !out) error = "closing " + tmpPath + " failed";
+    if (ok()) {
+        std::filesystem::rename(tmpPath, path, ec);
+        if (ec) error = "cannot rename " + tmpPath + " to " + path + ": " + ec.message();
+    }
+    if (!ok()) std::filesystem::remove(tmpPath, ec);
+    return ok();
+}
+
+// ---------------- ColumnarReader ----------------
+
+ColumnarReader::ColumnarReader(const string& path) {
+    in.open(path, std::ios::binary);
+    if (!in.is_open()) {
+        error = "cannot open " + path;
+        return;
+    }
+
+    in.seekg(0, std::ios::end);
+    std::streamoff fileSize = in.tellg();
+    if (fileSize < static_cast<std::streamoff>(headerSize + 4 + trailerSize)) {
+        error = path + " is not a columnar file (too short)";
+        return;
+    }
+
+    char header[headerSize];
+    in.seekg(0);
+    in.read(header, sizeof(header));
+    char trailer[trailerSize];
+    in.seekg(fileSize - static_cast<std::streamoff>(trailerSize));
+    in.read(trailer, sizeof(trailer));
+    if (!in || std::memcmp(header, fileMagic, sizeof(fileMagic)) != 0 ||
+        std::memcmp(trailer + 8, footerMagic, sizeof(footerMagic)) != 0) {
+        error = path + " is not a columnar file";
+        return;
+    }
+    if (getU32(header + sizeof(fileMagic)) != formatVersion) {
+        error = path + ": unsupported format version " + to_string(getU32(header + sizeof(fileMagic)));
+        return;
+    }
+
+    uint64_t footerOffset = getU64(trailer);
+    uint64_t footerEnd = static_cast<uint64_t>(fileSize) - trailerSize;
+    if (footerOffset < headerSize || footerOffset > footerEnd) {
+        error = path + ": corrupt footer";
+        return;
+    }
+    string footer(static_cast<size_t>(footerEnd - footerOffset), '\0');
+    in.seekg(static_cast<std::streamoff>(footerOffset));
+    in.read(&footer[0], static_cast<std::streamsize>(footer.size()));
+
+    const size_t entrySize = 8 + 8 + 4 * 5 + 8;
+    Cursor cursor(footer.data(), footer.data() + footer.size());
+    uint32_t count = cursor.u32();
+    if (!in || !cursor.ok || footer.size() != 4 + static_cast<size_t>(count) * entrySize) {
+        error = path + ": corrupt footer";
+        return;
+    }
+    groups.resize(count);
+    for (RowGroupInfo& group : groups) {
+        const char* at = cursor.take(entrySize);
+        group.offset = getU64(at);
+        group.size = getU64(at + 8);
+        group.rows = getU32(at + 16);
+        group.minDay = getI32(at + 20);
+        group.maxDay = getI32(at + 24);
+        group.minRoom = getI32(at + 28);
+        group.maxRoom = getI32(at + 32);
+        group.revenue = getF64(at + 36);
+        if (group.offset < headerSize || group.size > footerOffset - group.offset) {
+            error = path + ": corrupt footer";
+            groups.clear();
+            return;
+        }
+    }
+}
+
+uint64_t ColumnarReader::rowCount() const {
+    uint64_t rows = 0;
+    for (const RowGroupInfo& group : groups) rows += group.rows;
+    return rows;
+}
+
+ColumnarReader::ScanStats ColumnarReader::scan(int fromDay, int toDay,
+                                               const function<void(const Hotel::Reservation&)>& visit) {
+    ScanStats stats;
+    for (const RowGroupInfo& group : groups) {
+        if (!ok()) break;
+        if (group.maxDay < fromDay || group.minDay > toDay) {
+            ++stats.groupsSkipped;
+            continue;
+        }
+        readGroup(group, fromDay, toDay, &visit, stats);
+    }
+    return stats;
+}
+
+ColumnarReader::ScanStats ColumnarReader::revenue(int fromDay, int toDay) {
+    ScanStats stats;
+    for (const RowGroupInfo& group : groups) {
+        if (!ok()) break;
+        if (group.maxDay < fromDay || group.minDay > toDay) {
+            ++stats.groupsSkipped;
+        } else if (group.minDay >= fromDay && group.maxDay <= toDay) {
+            ++stats.groupsFromStatistics;
+            stats.rowsMatched += group.rows;
+            stats.revenue += group.revenue;
+        } else {
+            readGroup(group, fromDay, toDay, nullptr, stats);
+        }
+    }
+    return stats;
+}
+
+bool ColumnarReader::readGroup(const RowGroupInfo& group, int fromDay, int toDay,
+                               const function<void(const Hotel::Reservation&)>* visit,
+                               ScanStats& stats) {
+    buffer.resize(static_cast<size_t>(group.size));
+    in.clear();
+    in.seekg(static_cast<std::streamoff>(group.offset));
+    in.read(&buffer[0], static_cast<std::streamsize>(buffer.size()));
+    if (!in || buffer.size() < groupHeaderSize) {
+        error = "cannot read row group at offset " + to_string(group.offset);
+        return false;
+    }
+    ++stats.groupsRead;
+
+    const char* base = buffer.data();
+    const char* end = base + buffer.size();
+    uint32_t rows = getU32(base);
+    uint32_t offsets[ColumnCount];
+    for (int c = 0; c < ColumnCount; ++c) {
+        offsets[c] = getU32(base + 4 + 4 * c);
+        if (offsets[c] < groupHeaderSize || offsets[c] > buffer.size()) {
+            error = "corrupt row group at offset " + to_string(group.offset);
+            return false;
+        }
+    }
+    auto fixedColumn = [&](Column column, size_t width) -> const char* {
+        const char* at = base + offsets[column];
+        return static_cast<size_t>(end - at) / width < rows ? nullptr : at;
+    };
+
+    // Dates first: rows whose date code is out of range are never decoded
+    Cursor dateCursor(base + offsets[DateColumnIndex], end);
+    uint32_t dateCount = dateCursor.u32();
+    vector<int32_t> days;
+    vector<string> dateText;
+    vector<char> wanted;
+    bool anyWanted = false;
+    for (uint32_t i = 0; i < dateCount && dateCursor.ok; ++i) {
+        int32_t day = dateCursor.i32();
+        days.push_back(day);
+        dateText.push_back(day < 0 ? dateCursor.text() : string());
+        wanted.push_back(day >= fromDay && day <= toDay);
+        anyWanted = anyWanted || wanted.back();
+    }
+    Codes dateCodes;
+    const char* costs = fixedColumn(CostColumn, 8);
+    if (!dateCursor.ok || !readCodes(dateCursor, rows, dateCodes) || !costs) {
+        error = "corrupt row group at offset " + to_string(group.offset);
+        return false;
+    }
+    if (!anyWanted) return true;
+    if (visit) {
+        for (uint32_t i = 0; i < dateCount; ++i) {
+            if (wanted[i] && days[i] >= 0) dateText[i] = Hotel::dayNumberToDate(days[i]);
+        }
+    }
+
+    if (!visit) {
+        for (uint32_t row = 0; row < rows; ++row) {
+            uint32_t code = dateCodes[row];
+            if (code < dateCount && wanted[code]) {
+                ++stats.rowsMatched;
+                stats.revenue += getF64(costs + 8 * static_cast<size_t>(row));
+            }
+        }
+        return true;
+    }
+
+    vector<string> guestNames, typeNames;
+    Codes guestCodes, typeCodes;
+    Cursor guestCursor(base + offsets[GuestColumn], end);
+    Cursor typeCursor(base + offsets[RoomTypeColumn], end);
+    const char* roomData = fixedColumn(RoomColumn, 4);
+    const char* nightData = fixedColumn(NightsColumn, 4);
+    const char* hourData = fixedColumn(HourColumn, 4);
+    const char* priceData = fixedColumn(PriceColumn, 8);
+    const char* bookedData = fixedColumn(BookedColumn, 4);
+    if (!readStringColumn(guestCursor, rows, guestNames, guestCodes) ||
+        !readStringColumn(typeCursor, rows, typeNames, typeCodes) ||
+        !roomData || !nightData || !hourData || !priceData || !bookedData) {
+        error = "corrupt row group at offset " + to_string(group.offset);
+        return false;
+    }
+
+    Hotel::Reservation r;
+    for (uint32_t row = 0; row < rows; ++row) {
+        uint32_t dateCode = dateCodes[row];
+        if (dateCode >= dateCount || !wanted[dateCode]) continue;
+        uint32_t guestCode = guestCodes[row];
+        uint32_t typeCode = typeCodes[row];
+        if (guestCode >= guestNames.size() || typeCode >= typeNames.size()) {
+            error = "corrupt row group at offset " + to_string(group.offset);
+            return false;
+        }
+        size_t at = row;
+        r.guestName = guestNames[guestCode];
+        r.roomType = typeNames[typeCode];
+        r.stayDate = dateText[dateCode];
+        r.roomNumber = getI32(roomData + 4 * at);
+        r.nights = getI32(nightData + 4 * at);
+        r.checkInHour = getI32(hourData + 4 * at);
+        r.pricePerNight = getF64(priceData + 8 * at);
+        r.totalCost = getF64(costs + 8 * at);
+        r.bookedDay = getI32(bookedData + 4 * at);
+        ++stats.rowsMatched;
+        stats.revenue += r.totalCost;
+        (*visit)(r);
+    }
+    return true;
+}
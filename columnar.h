@@ -0,0 +1,158 @@
+#ifndef COLUMNAR_H
+#define COLUMNAR_H
+
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <functional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "hotel.h"
+
+// Columnar export of reservations for analytics.
+//
+// A file is a sequence of row groups followed by a footer:
+//
+//   "HCOL" u32 version
+//   row group * N
+//   footer: u32 groupCount, then per group its offset, size and statistics
+//           (rows, min/max stay day, min/max room, revenue)
+//   u64 footerOffset, "HCOLEND\0"
+//
+// Inside a row group every column is stored contiguously. Guest name, room
+// type and stay date are dictionary-encoded per row group (dictionary, then
+// one 1/2/4-byte code per row); room, nights, check-in hour, price, cost
+// and booking day are plain typed arrays. Stay dates are stored as day
+// numbers (see Hotel::dateToDayNumber), with the original text kept only for
+// invalid dates. A table of column offsets after the row count lets a reader decode
+// just the columns it needs. All integers and doubles are little-endian.
+//
+// The writer holds at most one row group in memory; the reader reads the
+// footer up front and then one row group at a time, skipping groups whose
+// date statistics fall outside the requested range.
+
+// Statistics kept per row group (and used for predicate pushdown)
+struct RowGroupInfo {
+    std::uint64_t offset = 0;
+    std::uint64_t size = 0;
+    std::uint32_t rows = 0;
+    std::int32_t minDay = 0;      // -1 if any row has an invalid date
+    std::int32_t maxDay = 0;
+    std::int32_t minRoom = 0;
+    std::int32_t maxRoom = 0;
+    double revenue = 0.0;         // sum of totalCost
+};
+
+class ColumnarWriter {
+public:
+    explicit ColumnarWriter(const std::string& path, std::size_t rowGroupRows = 65536);
+    ~ColumnarWriter();
+
+    ColumnarWriter(const ColumnarWriter&) = delete;
+    ColumnarWriter& operator=(const ColumnarWriter&) = delete;
+
+    bool ok() const { return error.empty(); }
+    const std::string& lastError() const { return error; }
+
+    // Buffer one row; writes a row group whenever rowGroupRows are buffered
+    void append(const Hotel::Reservation& r);
+
+    // Write the last row group and the footer, then move the file into
+    // place. Returns false (and removes the partial file) on any I/O error.
+    // A writer destroyed without close() leaves no file behind.
+    bool close();
+
+    std::uint64_t rowsWritten() const { return totalRows; }
+    std::size_t rowGroupsWritten() const { return groups.size(); }
+
+private:
+    // One dictionary-encoded string column of the current row group
+    struct StringColumn {
+        std::unordered_map<std::string, std::uint32_t> codes;
+        std::vector<const std::string*> values;          // by code
+        std::vector<std::uint32_t> rows;
+        void add(const std::string& value);
+        void clear();
+    };
+
+    struct DateColumn {
+        std::unordered_map<std::string, std::uint32_t> codes;
+        std::vector<std::int32_t> days;                  // by code, -1 if invalid
+        std::vector<const std::string*> values;          // by code
+        std::vector<std::uint32_t> rows;
+        std::int32_t add(const std::string& date);       // returns the day
+        void clear();
+    };
+
+    void flushGroup();
+    void write(const std::string& bytes);
+
+    std::string path;
+    std::string tmpPath;
+    std::ofstream out;
+    std::string error;
+    std::size_t rowGroupRows;
+    std::uint64_t offset = 0;
+    std::uint64_t totalRows = 0;
+    bool closed = false;
+
+    // Current row group
+    StringColumn guests;
+    StringColumn roomTypes;
+    DateColumn dates;
+    std::vector<std::int32_t> rooms;
+    std::vector<std::int32_t> nights;
+    std::vector<std::int32_t> checkInHours;
+    std::vector<double> prices;
+    std::vector<double> costs;
+    std::vector<std::int32_t> bookedDays;
+    RowGroupInfo current;
+
+    std::vector<RowGroupInfo> groups;
+    std::string buffer;                                  // one encoded row group
+};
+
+class ColumnarReader {
+public:
+    // Opens the file and reads its footer
+    explicit ColumnarReader(const std::string& path);
+
+    bool ok() const { return error.empty(); }
+    const std::string& lastError() const { return error; }
+
+    const std::vector<RowGroupInfo>& rowGroups() const { return groups; }
+    std::uint64_t rowCount() const;
+
+    struct ScanStats {
+        std::size_t groupsRead = 0;
+        std::size_t groupsSkipped = 0;     // pruned by their date statistics
+        std::size_t groupsFromStatistics = 0;
+        std::uint64_t rowsMatched = 0;
+        double revenue = 0.0;
+    };
+
+    // Visit every row whose stay day lies in [fromDay, toDay], in file
+    // order. Row groups outside the range are never read. Rows with an
+    // invalid date have day -1 (INT_MIN..INT_MAX visits everything).
+    ScanStats scan(int fromDay, int toDay,
+                   const std::function<void(const Hotel::Reservation&)>& visit);
+
+    // Revenue of stays in [fromDay, toDay]. Row groups entirely inside the
+    // range are answered from their statistics without being read.
+    ScanStats revenue(int fromDay, int toDay);
+
+private:
+    // Decode one row group; rows outside [fromDay, toDay] are skipped
+    bool readGroup(const RowGroupInfo& group, int fromDay, int toDay,
+                   const std::function<void(const Hotel::Reservation&)>* visit,
+                   ScanStats& stats);
+
+    std::ifstream in;
+    std::string error;
+    std::vector<RowGroupInfo> groups;
+    std::string buffer;
+};
+
+#endif // COLUMNAR_H
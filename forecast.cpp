@@ -0,0 +1,141 @@
+#include "forecast.h"
+
+#include <algorithm>
+#include <chrono>
+
+using namespace std;
+
+BookingForecaster::BookingForecaster(int asOfDay, const vector<RoomTypeInfo>& types, int historyDays)
+    : asOfDay(asOfDay),
+      historyDays(historyDays < 1 ? 1 : historyDays),
+      types(types),
+      onBooksNights(types.size() * horizonDays, 0.0),
+      onBooksRevenue(types.size() * horizonDays, 0.0),
+      leadNights(types.size() * (maxLead + 1), 0.0),
+      datedNights(types.size(), 0.0),
+      undatedNights(types.size(), 0.0),
+      earliestHistoryDay(asOfDay),
+      pickup(types.size() * horizonDays, 0.0),
+      pickupStale(true) {
+    result.asOfDay = asOfDay;
+    result.types.resize(types.size());
+    for (size_t t = 0; t < types.size(); ++t) {
+        typeIndex[types[t].name] = static_cast<int>(t);
+        TypeForecast& type = result.types[t];
+        type.name = types[t].name;
+        type.totalRooms = types[t].totalRooms;
+        type.onBooks.assign(horizonDays, 0.0);
+        type.projected.assign(horizonDays, 0.0);
+        type.revenue.assign(horizonDays, 0.0);
+        type.pace.assign(maxLead + 1, 0.0);
+    }
+}
+
+void BookingForecaster::addStay(const string& roomType, int arrivalDay, int nights,
+                                int bookedDay, double totalCost) {
+    apply(roomType, arrivalDay, nights, bookedDay, totalCost, 1.0);
+}
+
+void BookingForecaster::removeStay(const string& roomType, int arrivalDay, int nights,
+                                   int bookedDay, double totalCost) {
+    apply(roomType, arrivalDay, nights, bookedDay, totalCost, -1.0);
+}
+
+void BookingForecaster::apply(const string& roomType, int arrivalDay, int nights,
+                              int bookedDay, double totalCost, double sign) {
+    auto it = typeIndex.find(roomType);
+    if (it == typeIndex.end() || arrivalDay < 0) return;
+    const size_t t = static_cast<size_t>(it->second);
+    nights = std::max(nights, 1);
+    const double rate = totalCost / nights;
+
+    // Only the nights inside the history window or the horizon matter
+    int first = std::max(arrivalDay, asOfDay - historyDays);
+    int last = std::min(arrivalDay + nights, asOfDay + horizonDays);
+    for (int night = first; night < last; ++night) {
+        int k = night - asOfDay;
+        if (k >= 0) {
+            // Bookings made after the as-of day are not on its books yet
+            if (bookedDay > asOfDay) continue;
+            onBooksNights[t * horizonDays + k] += sign;
+            onBooksRevenue[t * horizonDays + k] += sign * rate;
+        }
+        else {
+            if (bookedDay >= 0) {
+                int lead = std::min(std::max(night - bookedDay, 0), maxLead);
+                leadNights[t * (maxLead + 1) + lead] += sign;
+                datedNights[t] += sign;
+            }
+            else {
+                undatedNights[t] += sign;
+            }
+            earliestHistoryDay = std::min(earliestHistoryDay, night);
+            pickupStale = true;
+        }
+    }
+}
+
+// Pickup for a night k days out = average history room-nights booked
+// fewer than k days before arrival, scaled up for history rows that have
+// no booking date (assumed to follow the same pace)
+void BookingForecaster::rebuildPickup() {
+    const int observedDays = std::max(1, asOfDay - std::max(asOfDay - historyDays, earliestHistoryDay));
+
+    for (size_t t = 0; t < types.size(); ++t) {
+        const double* leads = &leadNights[t * (maxLead + 1)];
+        double* curve = &pickup[t * horizonDays];
+        TypeForecast& type = result.types[t];
+        const double dated = datedNights[t];
+        type.hasPace = dated > 0.0;
+
+        const double perNight = type.hasPace
+            ? (dated + undatedNights[t]) / dated / observedDays
+            : 0.0;
+        double below = 0.0;
+        for (int k = 0; k < horizonDays; ++k) {
+            curve[k] = below * perNight;
+            below += leads[k];
+        }
+
+        // Share of the final room-nights already booked at each lead time
+        double remaining = dated;
+        for (int lead = 0; lead <= maxLead; ++lead) {
+            type.pace[lead] = type.hasPace ? remaining / dated : 0.0;
+            remaining -= leads[lead];
+        }
+    }
+    pickupStale = false;
+}
+
+const BookingForecaster::Forecast& BookingForecaster::forecast() {
+    using Clock = std::chrono::steady_clock;
+    Clock::time_point start = Clock::now();
+
+    if (pickupStale) rebuildPickup();
+
+    result.totalRevenue = 0.0;
+    for (size_t t = 0; t < types.size(); ++t) {
+        const double* booked = &onBooksNights[t * horizonDays];
+        const double* bookedRevenue = &onBooksRevenue[t * horizonDays];
+        const double* expected = &pickup[t * horizonDays];
+        const double rooms = types[t].totalRooms;
+        const double price = types[t].pricePerNight;
+        TypeForecast& type = result.types[t];
+        double* projected = type.projected.data();
+        double* revenue = type.revenue.data();
+
+        // Straight-line loops over flat arrays (vectorized by the compiler)
+        double typeRevenue = 0.0;
+        for (int k = 0; k < horizonDays; ++k) {
+            double nights = std::max(booked[k], std::min(rooms, booked[k] + expected[k]));
+            projected[k] = nights;
+            revenue[k] = bookedRevenue[k] + (nights - booked[k]) * price;
+            typeRevenue += revenue[k];
+        }
+        std::copy(booked, booked + horizonDays, type.onBooks.begin());
+        result.totalRevenue += typeRevenue;
+    }
+
+    result.computeMicros = std::chrono::duration<double, std::micro>(Clock::now() - start).count();
+    return result;
+}
@@ -0,0 +1,101 @@
+#ifndef FORECAST_H
+#define FORECAST_H
+
+#include <cstddef>
+#include <map>
+#include <string>
+#include <vector>
+
+// Occupancy and revenue forecast from booking pace.
+//
+// The forecaster is built for one "as of" day. It is fed stays (addStay /
+// removeStay) and keeps two sets of flat per-type arrays:
+//
+//   on the books  - room-nights and revenue already booked for each of the
+//                   next horizonDays nights
+//   booking pace  - for nights in the history window before the as-of day,
+//                   how many room-nights were booked at each lead time
+//                   (night minus booking day, capped at maxLead)
+//
+// A night `k` days ahead can still pick up the bookings that history made
+// at lead times below k. forecast() turns the pace histogram into a
+// cumulative pickup curve (only when history changed) and projects every
+// type and night in one pass over contiguous arrays:
+//
+//   rooms = min(totalRooms, onBooks[k] + pickup[k])
+//
+// Booking a stay only touches its own nights, so refreshing after each
+// booking is a few adds plus the projection pass.
+class BookingForecaster {
+public:
+    static constexpr int horizonDays = 90;
+    static constexpr int maxLead = 365;
+    static constexpr int defaultHistoryDays = 365;
+
+    struct RoomTypeInfo {
+        std::string name;
+        int totalRooms;
+        double pricePerNight;
+    };
+
+    // One room type's projection, indexed by nights after the as-of day
+    struct TypeForecast {
+        std::string name;
+        int totalRooms = 0;
+        std::vector<double> onBooks;          // room-nights booked
+        std::vector<double> projected;        // room-nights expected
+        std::vector<double> revenue;          // booked + expected pickup
+        std::vector<double> pace;             // share of final nights on the books at each lead
+        bool hasPace = false;                 // history with booking dates
+    };
+
+    struct Forecast {
+        int asOfDay = -1;
+        std::vector<TypeForecast> types;      // in the order given to the constructor
+        double totalRevenue = 0.0;
+        double computeMicros = 0.0;           // last forecast() call
+    };
+
+    // historyDays: nights before asOfDay used for the pace curves
+    BookingForecaster(int asOfDay, const std::vector<RoomTypeInfo>& types, int historyDays = defaultHistoryDays);
+
+    int day() const { return asOfDay; }
+
+    // A stay of `nights` from arrivalDay, booked on bookedDay (-1 if not
+    // known) for totalCost. Stays of unknown room types are ignored.
+    void addStay(const std::string& roomType, int arrivalDay, int nights,
+                 int bookedDay, double totalCost);
+    void removeStay(const std::string& roomType, int arrivalDay, int nights,
+                    int bookedDay, double totalCost);
+
+    // Project all types over the horizon
+    const Forecast& forecast();
+
+private:
+    void apply(const std::string& roomType, int arrivalDay, int nights,
+               int bookedDay, double totalCost, double sign);
+    void rebuildPickup();
+
+    int asOfDay;
+    int historyDays;
+    std::vector<RoomTypeInfo> types;
+    std::map<std::string, int> typeIndex;
+
+    // Per type, type-major: onBooks[type * horizonDays + k]
+    std::vector<double> onBooksNights;
+    std::vector<double> onBooksRevenue;
+
+    // Per type: leadNights[type * (maxLead + 1) + lead], history nights by lead
+    std::vector<double> leadNights;
+    std::vector<double> datedNights;          // history nights with a booking date
+    std::vector<double> undatedNights;        // ... and without
+    int earliestHistoryDay;
+
+    // Per type: expected pickup for each night of the horizon
+    std::vector<double> pickup;
+    bool pickupStale;
+
+    Forecast result;
+};
+
+#endif // FORECAST_H
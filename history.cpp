@@ -0,0 +1,235 @@
+#include "history.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <iterator>
+#include <limits>
+
+using namespace std;
+
+namespace fs = std::filesystem;
+using Clock = std::chrono::steady_clock;
+
+namespace {
+
+// Heap buffers of the strings in a page
+long long pageStringBytes(const HistoryStore::DayPage& page) {
+    long long bytes = heapBytes(page.date);
+    for (const Hotel::Reservation& r : page.rows) {
+        bytes += heapBytes(r.guestName) + heapBytes(r.roomType) + heapBytes(r.stayDate);
+    }
+    return bytes;
+}
+
+double millisSince(Clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+}
+
+} // namespace
+
+HistoryStore::HistoryStore(const std::string& directory, size_t budgetBytes)
+    : root(directory), budgetBytes(budgetBytes) {}
+
+std::shared_ptr<const HistoryStore::DayPage> HistoryStore::day(const std::string& date) {
+    std::lock_guard<std::mutex> lock(mutex);
+    auto it = entries.find(date);
+    if (it != entries.end()) {
+        ++counters.dayHits;
+        touch(it->second);
+        return it->second.page;
+    }
+    return loadDay(date);
+}
+
+std::vector<HistoryStore::GuestStay> HistoryStore::findGuest(const std::string& guestName) {
+    std::lock_guard<std::mutex> lock(mutex);
+
+    // One directory listing, on the first lookup rather than at start
+    if (!listed) {
+        std::error_code ec;
+        for (fs::directory_iterator it(root, ec), end; !ec && it != end; it.increment(ec)) {
+            if (it->path().extension() != ".txt") continue;
+            std::string date = it->path().stem().string();
+            if (Hotel::dateToDayNumber(date) < 0) continue;
+            datesByMonth[Hotel::Snapshot::monthOf(date)].insert(date);
+        }
+        listed = true;
+    }
+
+    std::vector<GuestStay> stays;
+    for (const auto& month : datesByMonth) {
+        std::shared_ptr<const MonthIndex> index;
+        auto it = entries.find(month.first);
+        if (it != entries.end()) {
+            touch(it->second);
+            index = it->second.index;
+        } else {
+            index = loadMonth(month.first);
+        }
+        auto stay = std::lower_bound(index->stays.begin(), index->stays.end(), guestName,
+                                     [&index](const MonthIndex::Stay& s, const std::string& name) {
+                                         return index->nameOf(s) < name;
+                                     });
+        for (; stay != index->stays.end() && index->nameOf(*stay) == guestName; ++stay) {
+            // MM-DD-YYYY from the "YYYY-MM" key and the day
+            char date[16];
+            std::snprintf(date, sizeof(date), "%s-%02d-%s", month.first.substr(5, 2).c_str(),
+                          stay->day, month.first.substr(0, 4).c_str());
+            stays.push_back({ date, stay->roomNumber, stay->nights });
+        }
+    }
+    return stays;
+}
+
+void HistoryStore::invalidate(const std::string& date) {
+    std::lock_guard<std::mutex> lock(mutex);
+    const std::string month = Hotel::Snapshot::monthOf(date);
+    for (const std::string& key : { date, month }) {
+        auto it = entries.find(key);
+        if (it != entries.end()) forget(it);
+    }
+
+    // Keep the listing in step with files created or removed since
+    if (listed) {
+        std::error_code ec;
+        if (fs::exists(fs::path(root) / (date + ".txt"), ec)) {
+            datesByMonth[month].insert(date);
+        } else if (datesByMonth.count(month)) {
+            datesByMonth[month].erase(date);
+            if (datesByMonth[month].empty()) datesByMonth.erase(month);
+        }
+    }
+}
+
+void HistoryStore::setBudget(size_t bytes) {
+    std::lock_guard<std::mutex> lock(mutex);
+    budgetBytes = bytes;
+    evict();
+}
+
+size_t HistoryStore::budget() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return budgetBytes;
+}
+
+HistoryStore::Stats HistoryStore::stats() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    Stats result = counters;
+    result.residentEntries = entries.size();
+    return result;
+}
+
+std::shared_ptr<const HistoryStore::DayPage> HistoryStore::loadDay(const std::string& date) {
+    Clock::time_point start = Clock::now();
+    ++counters.dayMisses;
+
+    Entry entry;
+    Hotel::DayFile file;
+    if (Hotel::parseDayFile((fs::path(root) / (date + ".txt")).string(), date, file) ==
+        Hotel::ParseStatus::Ok) {
+        std::shared_ptr<DayPage> page = std::make_shared<DayPage>();
+        page->date = date;
+        page->totalRevenue = file.totalRevenue;
+        page->rows.assign(std::make_move_iterator(file.rows.begin()),
+                          std::make_move_iterator(file.rows.end()));
+        entry.stringBytes = pageStringBytes(*page);
+        entry.bytes = static_cast<long long>(sizeof(DayPage) + page->rows.capacity() * sizeof(Hotel::Reservation)) +
+                      entry.stringBytes;
+        entry.page = page;
+    } else {
+        // Remember that there is no file, at the cost of the key
+        entry.bytes = static_cast<long long>(sizeof(Entry) + date.size());
+    }
+
+    std::shared_ptr<const DayPage> page = entry.page;
+    remember(date, std::move(entry));
+    counters.readMillis += millisSince(start);
+    return page;
+}
+
+std::shared_ptr<const HistoryStore::MonthIndex> HistoryStore::loadMonth(const std::string& month) {
+    Clock::time_point start = Clock::now();
+    ++counters.monthIndexesBuilt;
+
+    // Read the month's files straight into the index, so a guest search does
+    // not push the day pages other queries are using out of the cache
+    struct Row {
+        std::string guestName;
+        int day;
+        int roomNumber;
+        int nights;
+    };
+    std::vector<Row> rows;
+    Hotel::DayFile file;
+    for (const std::string& date : datesByMonth[month]) {
+        if (Hotel::parseDayFile((fs::path(root) / (date + ".txt")).string(), date, file) !=
+            Hotel::ParseStatus::Ok) {
+            continue;
+        }
+        const int day = std::atoi(date.substr(3, 2).c_str());
+        for (Hotel::Reservation& r : file.rows) {
+            if (r.guestName.size() > std::numeric_limits<uint16_t>::max()) continue;
+            rows.push_back({ std::move(r.guestName), day, r.roomNumber, r.nights });
+        }
+    }
+    std::sort(rows.begin(), rows.end(), [](const Row& a, const Row& b) {
+        if (a.guestName != b.guestName) return a.guestName < b.guestName;
+        return a.day < b.day;
+    });
+
+    std::shared_ptr<MonthIndex> index = std::make_shared<MonthIndex>();
+    index->stays.reserve(rows.size());
+    for (const Row& row : rows) {
+        if (index->stays.empty() || index->nameOf(index->stays.back()) != row.guestName) {
+            index->names += row.guestName;
+        }
+        index->stays.push_back({ static_cast<uint32_t>(index->names.size() - row.guestName.size()),
+                                 static_cast<uint16_t>(row.guestName.size()),
+                                 static_cast<uint8_t>(row.day), row.roomNumber, row.nights });
+    }
+    index->names.shrink_to_fit();
+    const long long strings = heapBytes(index->names);
+    const long long bytes = static_cast<long long>(sizeof(MonthIndex) +
+                                                   index->stays.capacity() * sizeof(MonthIndex::Stay));
+
+    Entry entry;
+    entry.index = index;
+    entry.stringBytes = strings;
+    entry.bytes = bytes + strings;
+    remember(month, std::move(entry));
+    counters.readMillis += millisSince(start);
+    return index;
+}
+
+void HistoryStore::remember(const std::string& key, Entry entry) {
+    lru.push_front(key);
+    entry.position = lru.begin();
+    counters.residentBytes += entry.bytes;
+    counters.residentStringBytes += entry.stringBytes;
+    if (entry.page) counters.residentRows += entry.page->rows.size();
+    entries[key] = std::move(entry);
+    counters.peakBytes = std::max(counters.peakBytes, counters.residentBytes);
+    evict();
+}
+
+void HistoryStore::forget(std::unordered_map<std::string, Entry>::iterator it) {
+    counters.residentBytes -= it->second.bytes;
+    counters.residentStringBytes -= it->second.stringBytes;
+    if (it->second.page) counters.residentRows -= it->second.page->rows.size();
+    lru.erase(it->second.position);
+    entries.erase(it);
+}
+
+void HistoryStore::touch(Entry& entry) {
+    lru.splice(lru.begin(), lru, entry.position);
+}
+
+void HistoryStore::evict() {
+    while (counters.residentBytes > static_cast<long long>(budgetBytes) && !lru.empty()) {
+        forget(entries.find(lru.back()));
+        ++counters.evictions;
+    }
+}
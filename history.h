@@ -0,0 +1,130 @@
+#ifndef HISTORY_H
+#define HISTORY_H
+
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "hotel.h"
+
+// Day files read on demand instead of imported up front.
+//
+// Nothing is read when a store is created. The first query for a date
+// parses that date's <MM-DD-YYYY>.txt into a page; the first guest lookup
+// lists the directory once and then builds one guest index per month as it
+// walks the months. Pages and month indexes share one LRU list and are
+// evicted, least recently used first, once their estimated heap use passes
+// the budget. A page handed out stays valid after it is evicted.
+//
+// Safe to use from any thread. The hotel invalidates a date whenever it
+// writes or removes that date's file.
+class HistoryStore {
+public:
+    typedef Counted<MemoryArea::HistoryCache>::vector<Hotel::Reservation> Rows;
+
+    // One date's file, as last read
+    struct DayPage {
+        std::string date;
+        double totalRevenue = 0.0;
+        Rows rows;
+    };
+
+    struct GuestStay {
+        std::string date;
+        int roomNumber;
+        int nights;
+    };
+
+    struct Stats {
+        size_t dayHits = 0;
+        size_t dayMisses = 0;           // pages read from disk
+        size_t monthIndexesBuilt = 0;
+        size_t evictions = 0;
+        size_t residentEntries = 0;     // pages and month indexes
+        size_t residentRows = 0;
+        long long residentBytes = 0;     // estimated, strings included
+        long long residentStringBytes = 0;
+        long long peakBytes = 0;
+        double readMillis = 0.0;        // parsing and indexing
+    };
+
+    static constexpr size_t defaultBudget = 64u << 20;
+
+    explicit HistoryStore(const std::string& directory, size_t budgetBytes = defaultBudget);
+
+    HistoryStore(const HistoryStore&) = delete;
+    HistoryStore& operator=(const HistoryStore&) = delete;
+
+    const std::string& directory() const { return root; }
+
+    // A date's page (nullptr if it has no file)
+    std::shared_ptr<const DayPage> day(const std::string& date);
+
+    // Every stay of a guest on file, in date order
+    std::vector<GuestStay> findGuest(const std::string& guestName);
+
+    // Forget what was read for a date (its file changed)
+    void invalidate(const std::string& date);
+
+    // Evicts at once if the new budget is smaller
+    void setBudget(size_t bytes);
+    size_t budget() const;
+
+    Stats stats() const;
+
+private:
+    // A month's stays sorted by guest, with each name stored once in one
+    // buffer: about 16 bytes a stay plus the names, instead of a hash node,
+    // a vector and a date string per guest
+    struct MonthIndex {
+        struct Stay {
+            uint32_t name;          // offset in names
+            uint16_t nameLength;
+            uint8_t day;            // day of the month
+            int roomNumber;
+            int nights;
+        };
+        std::string names;
+        Counted<MemoryArea::HistoryCache>::vector<Stay> stays;
+
+        std::string_view nameOf(const Stay& stay) const {
+            return std::string_view(names).substr(stay.name, stay.nameLength);
+        }
+    };
+
+    // Keys are dates (MM-DD-YYYY) for pages and months (YYYY-MM) for indexes
+    struct Entry {
+        std::shared_ptr<const DayPage> page;        // null for a missing file
+        std::shared_ptr<const MonthIndex> index;
+        long long bytes = 0;
+        long long stringBytes = 0;                  // part of bytes
+        std::list<std::string>::iterator position;
+    };
+
+    // Callers hold `mutex`
+    std::shared_ptr<const DayPage> loadDay(const std::string& date);
+    std::shared_ptr<const MonthIndex> loadMonth(const std::string& month);
+    void remember(const std::string& key, Entry entry);
+    void forget(std::unordered_map<std::string, Entry>::iterator it);
+    void touch(Entry& entry);
+    void evict();
+
+    std::string root;
+    size_t budgetBytes;
+    mutable std::mutex mutex;
+    std::unordered_map<std::string, Entry> entries;
+    std::list<std::string> lru;                         // most recent first
+    bool listed = false;
+    std::map<std::string, std::set<std::string>> datesByMonth;   // from the directory listing
+    Stats counters;
+};
+
+#endif // HISTORY_H
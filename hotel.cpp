@@ -0,0 +1,2149 @@
+#include "hotel.h"
+#include "columnar.h"
+#include "history.h"
+
+#include <iostream>
+#include <fstream>
+#include <ctime>
+#include <algorithm>
+#include <atomic>
+#include <cctype>
+#include <cerrno>
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
+#include <iomanip>
+#include <limits>
+#include <thread>
+#include <queue>         // Queue (for BFS)
+#include <set>           // For BFS visited set
+
+using namespace std;
+
+// Helper: split a string by a delimiter (used for file parsing)
+vector<string> Hotel::split(const string& s, char delim) {
+    vector<string> result;
+    size_t pos = 0;
+
+    // Same fields as getline() on a stringstream: a trailing delimiter
+    // does not produce an empty last field
+    while (pos < s.size()) {
+        size_t next = s.find(delim, pos);
+        if (next == string::npos) {
+            result.push_back(s.substr(pos));
+            break;
+        }
+        result.push_back(s.substr(pos, next - pos));
+        pos = next + 1;
+    }
+
+    return result;
+}
+
+string Hotel::quoteField(const string& s) {
+    if (s.find_first_of(",\"") == string::npos) return s;
+    string quoted = "\"";
+    for (char c : s) {
+        if (c == '"') quoted += '"';
+        quoted += c;
+    }
+    return quoted + "\"";
+}
+
+vector<string> Hotel::splitRow(const string& line) {
+    vector<string> result;
+    string field;
+    bool quoted = false;
+    for (size_t i = 0; i < line.size(); ++i) {
+        char c = line[i];
+        if (quoted) {
+            if (c != '"') field += c;
+            else if (i + 1 < line.size() && line[i + 1] == '"') field += line[++i];
+            else quoted = false;
+        }
+        else if (c == '"' && field.empty()) quoted = true;
+        else if (c == ',') {
+            result.push_back(field);
+            field.clear();
+        }
+        else field += c;
+    }
+    result.push_back(field);
+    return result;
+}
+
+// ---- Tree helper functions ----
+Hotel::TreeNode* Hotel::insertRoomInTree(TreeNode* node, int roomNumber) {
+    if (!node) {
+        TreeNode* newNode = new TreeNode{ roomNumber, nullptr, nullptr };
+        return newNode;
+    }
+    if (roomNumber < node->roomNumber) {
+        node->left = insertRoomInTree(node->left, roomNumber);
+    }
+    else if (roomNumber > node->roomNumber) {
+        node->right = insertRoomInTree(node->right, roomNumber);
+    }
+    // Ignore duplicates
+    return node;
+}
+
+Hotel::TreeNode* Hotel::findMinNode(TreeNode* node) {
+    while (node && node->left) {
+        node = node->left;
+    }
+    return node;
+}
+
+Hotel::TreeNode* Hotel::removeRoomFromTree(TreeNode* node, int roomNumber) {
+    if (!node) return nullptr;
+
+    if (roomNumber < node->roomNumber) {
+        node->left = removeRoomFromTree(node->left, roomNumber);
+    }
+    else if (roomNumber > node->roomNumber) {
+        node->right = removeRoomFromTree(node->right, roomNumber);
+    }
+    else {
+        // Found node to remove
+        if (!node->left) {
+            TreeNode* rightChild = node->right;
+            delete node;
+            return rightChild;
+        }
+        else if (!node->right) {
+            TreeNode* leftChild = node->left;
+            delete node;
+            return leftChild;
+        }
+        else {
+            // Two children: replace with inorder successor
+            TreeNode* successor = findMinNode(node->right);
+            node->roomNumber = successor->roomNumber;
+            node->right = removeRoomFromTree(node->right, successor->roomNumber);
+        }
+    }
+    return node;
+}
+
+void Hotel::inorderPrint(TreeNode* node) {
+    if (!node) return;
+    inorderPrint(node->left);
+    cout << node->roomNumber << " ";
+    inorderPrint(node->right);
+}
+
+void Hotel::clearTree(TreeNode* node) {
+    if (!node) return;
+    clearTree(node->left);
+    clearTree(node->right);
+    delete node;
+}
+
+// Requirement 6: Ability to reset hotel state for a "new day"
+void Hotel::resetStateForNewDate() {
+    totalRevenue = 0.0;
+    people.clear();
+    roomsnums.clear();
+    reservations.clear();
+    guestHistory.clear();
+    guestToRooms.clear();
+    sessionLog.clear();
+    guestLog.clear();
+    partitionRows.clear();
+    mergedEndsAfter.clear();
+    for (const auto& month : frozenDays) {
+        for (const auto& day : month.second) {
+            stalePartitions.insert(day.first);
+        }
+    }
+
+    // Clear undo stack
+    while (!bookingHistory.empty()) {
+        bookingHistory.pop();
+    }
+
+    // Clear tree
+    clearTree(occupiedRoomsRoot);
+    occupiedRoomsRoot = nullptr;
+
+    // The turnover plan, forecast and calendar were built from the old state
+    turnover.reset();
+    forecaster.reset();
+    forecastFileRows.clear();
+    calendar.clear();
+
+    // Reset availability for each room type
+    for (auto& pair : roomTypes) {
+        RoomType& rt = pair.second;
+        rt.availableRooms = rt.totalRooms;
+        rt.guests.clear();
+        rt.availableRoomNumbers = rt.allRoomNumbers;
+    }
+    // roomGraph is structural; we do NOT clear it here.
+}
+
+// Core booking logic (does NOT touch totalRevenue directly)
+bool Hotel::coversLoadedDay(int startDay, int nights) const {
+    int loadedDay = dateToDayNumber(loadedDate);
+    if (startDay < 0 || loadedDay < 0) return true;
+    return startDay <= loadedDay && loadedDay < startDay + std::max(nights, 1);
+}
+
+bool Hotel::holdRoom(RoomTypeIt typeIt, int roomNumber, int startDay, int nights,
+                     const std::string& guestName) {
+    // The room must be free for every night of the stay
+    int endDay = startDay + std::max(nights, 1);
+    if (startDay >= 0 && !calendar.isFree(roomNumber, startDay, endDay)) {
+        return false;
+    }
+
+    if (coversLoadedDay(startDay, nights)) {
+        // Stay includes today: take the room out of today's availability
+        RoomType& rt = typeIt->second;
+        auto itRoomNumber = std::find(rt.availableRoomNumbers.begin(),
+                                      rt.availableRoomNumbers.end(),
+                                      roomNumber);
+        if (itRoomNumber == rt.availableRoomNumbers.end()) {
+            return false;
+        }
+
+        rt.guests[roomNumber] = guestName;
+        rt.availableRoomNumbers.erase(itRoomNumber);
+        rt.availableRooms--;
+
+        // Insert into tree of occupied rooms
+        occupiedRoomsRoot = insertRoomInTree(occupiedRoomsRoot, roomNumber);
+    }
+
+    if (startDay >= 0) {
+        calendar.book(roomNumber, startDay, endDay);
+    }
+    return true;
+}
+
+bool Hotel::bookRoom(const std::string& guestName,
+                     const std::string& date,
+                     int roomNumber,
+                     int nights) {
+    RoomTypeIt typeIt = roomTypeForRoom(roomNumber);
+    if (typeIt == roomTypes.end() ||
+        !holdRoom(typeIt, roomNumber, dateToDayNumber(date), nights, guestName)) {
+        return false;
+    }
+
+    reservations[date][roomNumber] = guestName;
+    people.push_back(guestName);
+    roomsnums.push_back(roomNumber);
+    sessionLog.push_back({ guestName, roomNumber });
+
+    // Update hash table
+    guestToRooms[guestName].push_back(roomNumber);
+
+    // Update guest history list
+    guestHistory.push_back(guestName);
+    guestLog.push_back(guestName);
+
+    return true;
+}
+
+// ---- Runtime-configured catalog lookups ----
+Hotel::RoomTypeIt Hotel::roomTypeForRoom(int roomNumber) {
+    for (RoomTypeIt it = roomTypes.begin(); it != roomTypes.end(); ++it) {
+        const std::vector<int>& rooms = it->second.allRoomNumbers;
+        if (std::find(rooms.begin(), rooms.end(), roomNumber) != rooms.end()) {
+            return it;
+        }
+    }
+    return roomTypes.end();
+}
+
+Hotel::RoomTypeIt Hotel::roomTypeByOption(int option) {
+    if (option < 1 || option > static_cast<int>(roomTypes.size())) {
+        return roomTypes.end();
+    }
+    RoomTypeIt it = roomTypes.begin();
+    std::advance(it, option - 1);
+    return it;
+}
+
+bool Hotel::roomNeighbors(int roomNumber, const int*& first, size_t& count) {
+    auto it = roomGraph.find(roomNumber);
+    if (it == roomGraph.end()) {
+        return false;
+    }
+    first = it->second.data();
+    count = it->second.size();
+    return true;
+}
+
+Hotel::Hotel(std::string hotelName, int totalRooms)
+    : name(hotelName),
+      totalRooms(totalRooms),
+      totalRevenue(0.0),
+      occupiedRoomsRoot(nullptr),
+      bestFitAssignment(true),
+      stopFlusher(false),
+      snapshotVersion(0) {
+    publishSnapshot();
+}
+
+Hotel::~Hotel() {
+    stopBackgroundFlusher();
+    clearTree(occupiedRoomsRoot);
+}
+
+// Requirement 9: Show menu-driven interface
+void Hotel::showOptions() {
+    std::cout << "\nChoose an action:\n";
+    std::cout << "1. Reserve a room\n";
+    std::cout << "2. Display total revenue and guests\n";
+    std::cout << "3. Display room availability\n";
+    std::cout << "4. Save information to file\n";
+    std::cout << "5. Show reservations for a specific date\n";
+    std::cout << "6. New Day (switch date)\n";
+    std::cout << "7. Exit\n";
+    std::cout << "8. Find guest by name (hash table lookup)\n";
+    std::cout << "9. Undo last booking (stack)\n";
+    std::cout << "10. Show reachable rooms from a room (graph BFS)\n";
+    std::cout << "11. Show guest history (list)\n";
+    std::cout << "12. Bulk import reservation files from a directory\n";
+    std::cout << "13. Housekeeping turnover plan for a date\n";
+    std::cout << "14. Re-optimize future room assignments (nightly batch)\n";
+    std::cout << "15. Show memory usage by structure\n";
+    std::cout << "16. Export reservations to a columnar file\n";
+    std::cout << "17. Scan a columnar file for a date range\n";
+    std::cout << "18. Occupancy and revenue forecast (next 90 nights)\n";
+}
+
+// Requirement 10: Display available room types and counts
+void Hotel::showAvailableRooms(const string& todayDate) {
+    std::shared_ptr<const Snapshot> view = snapshot();
+    std::cout << "\nWelcome to " << name << "!" << std::endl;
+    std::cout << "Today's date: " << todayDate << std::endl;
+    std::cout << "Choose a room type to reserve:\n";
+    int option = 1;
+    for (const Snapshot::TypeAvailability& rt : view->roomTypes) {
+        std::cout << option++ << ". " << rt.name
+                  << " - " << rt.availableRooms << " available - $"
+                  << rt.pricePerNight << " a night - Rooms "
+                  << rt.roomRange << "\n";
+    }
+}
+
+// Requirement 11: Prompt user for reservation details (date, nights, time)
+void Hotel::promptForReservationDetails(std::string& startDate,
+                                        std::string& endDate,
+                                        int& startTime,
+                                        int& durationDays) {
+    cout << "\n--- Reservation Details ---\n";
+
+    cout << "Enter reservation start date (MM-DD-YYYY) "
+         << "or '.' to use today's date (" << startDate << "): ";
+    std::string input;
+    cin >> input;
+
+    if (input != ".") {
+        startDate = input;
+    }
+
+    cout << "How many nights will you stay? ";
+    cin >> durationDays;
+    while (durationDays <= 0) {
+        cout << "Nights must be at least 1. Enter again: ";
+        cin >> durationDays;
+    }
+
+    cout << "Enter check-in time (0 – 23 hours): ";
+    cin >> startTime;
+    while (startTime < 0 || startTime > 23) {
+        cout << "Invalid time. Enter check-in hour between 0–23: ";
+        cin >> startTime;
+    }
+
+    // For simplicity, treat endDate as same as startDate (no date math)
+    endDate = startDate;
+
+    cout << "\nReservation date: " << startDate
+         << "\nNights: " << durationDays
+         << "\nCheck-in time: " << startTime << ":00\n\n";
+}
+
+// Requirement 12: Reserve a room of given type (option) for a guest
+int Hotel::reserveRoom(int option,
+                       const std::string& guestName,
+                       const std::string& startDate,
+                       const std::string& endDate,
+                       int startTime,
+                       int durationDays,
+                       double* bookedCost) {
+    (void)endDate;  // same as startDate for now (no date math)
+
+    RoomTypeIt it = roomTypeByOption(option);
+    if (it == roomTypes.end()) {
+        std::cout << "Invalid room type option.\n";
+        return -1;
+    }
+    RoomType& rt = it->second;
+
+    // The stay's dates on file, and stays on file running into them, must
+    // be in memory before a room is picked
+    int startDay = dateToDayNumber(startDate);
+    bool merged = startDay >= 0 &&
+                  mergeStaysFromDisk(startDay - (stayLookbackDays - 1),
+                                     startDay + std::max(durationDays, 1) - 1, startDay);
+
+    // Stays that include today must use one of today's free rooms; later
+    // stays can use any room of the type that is free for all their nights
+    const std::vector<int>& candidates = coversLoadedDay(startDay, durationDays)
+                                             ? rt.availableRoomNumbers
+                                             : rt.allRoomNumbers;
+    int roomNumber = -1;
+    if (startDay < 0) {
+        roomNumber = candidates.empty() ? -1 : candidates.front();
+    }
+    else if (bestFitAssignment) {
+        roomNumber = calendar.bestFit(candidates, startDay, startDay + durationDays);
+    }
+    else {
+        roomNumber = calendar.firstFit(candidates, startDay, startDay + durationDays);
+    }
+
+    if (roomNumber < 0) {
+        if (merged) publishSnapshot();
+        std::cout << "No available rooms for selected type.\n";
+        return -1;
+    }
+
+    if (bookRoom(guestName, startDate, roomNumber, durationDays)) {
+        double totalCost = rt.pricePerNight * durationDays;
+
+        // Update revenue for this session
+        totalRevenue += totalCost;
+
+        // Push full info to undo stack
+        bookingHistory.push({ guestName,
+                              startDate,
+                              roomNumber,
+                              durationDays,
+                              rt.pricePerNight,
+                              totalCost });
+
+        // Record detailed reservation (for saving later)
+        Reservation r;
+        r.guestName     = guestName;
+        r.roomNumber    = roomNumber;
+        r.roomType      = it->first;
+        r.stayDate      = startDate;       // reservation date
+        r.nights        = durationDays;
+        r.checkInHour   = startTime;
+        r.pricePerNight = rt.pricePerNight;
+        r.totalCost     = totalCost;
+        r.bookedDay     = dateToDayNumber(loadedDate);
+        partitionRows[startDate].push_back(r);
+        changedDates.insert(startDate);
+        notifyTurnover(r, true);
+        notifyForecast(r, true);
+        stalePartitions.insert(startDate);
+        publishSnapshot();
+
+        cout << "\n--- Reservation Complete ---\n";
+        cout << "Guest Name     : " << guestName << "\n";
+        cout << "Room Type      : " << it->first << "\n";
+        cout << "Room Number    : " << roomNumber << "\n";
+        cout << "Check-in Time  : " << startTime << ":00\n";
+        cout << "Nights         : " << durationDays << "\n";
+        cout << "Price per Night: $" << rt.pricePerNight << "\n";
+        cout << "Total Cost     : $" << totalCost << "\n";
+        cout << "-----------------------------\n\n";
+        if (bookedCost) *bookedCost = totalCost;
+        return roomNumber;
+    }
+
+    if (merged) publishSnapshot();
+    std::cout << "Failed to reserve room.\n";
+    return -1;
+}
+
+// Requirement 13: Show total revenue and list of guests for current date
+void Hotel::getTotal() {
+    std::shared_ptr<const Snapshot> view = snapshot();
+    std::cout << "\nHotel: " << name << std::endl;
+    std::cout << "Total Revenue (for current loaded date): $"
+              << view->totalRevenue << std::endl;
+
+    if (!view->sessionBookings.empty()) {
+        std::cout << "Current reservations:\n";
+        Snapshot::SessionChunks::forEach(view->sessionBookings,
+            [](const Snapshot::SessionBooking& b) {
+                std::cout << "  Guest Name: " << b.guestName
+                          << " | Room Number: " << b.roomNumber << std::endl;
+            });
+    }
+    else {
+        std::cout << "No reservations made yet for this date.\n";
+    }
+}
+
+// Requirement 14: Display room availability by type
+void Hotel::displayRoomAvailability() {
+    std::shared_ptr<const Snapshot> view = snapshot();
+    std::cout << "\nRoom Availability:\n";
+    for (const Snapshot::TypeAvailability& rt : view->roomTypes) {
+        std::cout << "  " << rt.name << " - "
+                  << rt.availableRooms << " available\n";
+    }
+}
+
+// Requirement 15: Save reservations for a **specific reservation date** to a text file
+//   File name: <date>.txt
+//   Line 1: TOTAL_REVENUE=<value for that date>
+//   Line 2: Header
+//   Next lines: reservations whose stayDate == date
+void Hotel::saveToFile(const string& date) {
+    auto it = partitionRows.find(date);
+    if (it == partitionRows.end() || it->second.size() == 0) {
+        std::cout << "No reservations to save for " << date << ".\n";
+        return;
+    }
+
+    // Written the way the flusher writes it, and never at the same time
+    std::lock_guard<std::mutex> writeLock(flushMutex);
+    std::map<std::string, std::vector<Reservation>> removed;
+    {
+        std::lock_guard<std::mutex> lock(storeMutex);
+        dirtyDates.erase(date);
+        auto pending = removedRows.find(date);
+        if (pending != removedRows.end()) {
+            removed[date] = std::move(pending->second);
+            removedRows.erase(pending);
+        }
+    }
+    if (writeDates({ date }, removed) == 0) {
+        std::cout << "Could not save " << date << ".txt." << std::endl;
+        return;
+    }
+    std::cout << "Data saved to file: " << date << ".txt" << std::endl;
+}
+
+// Write <date>.txt in the current format. The file is written next to the
+// target and renamed over it, so a reader never sees a half-written day.
+bool Hotel::writeDayFile(const string& date, const vector<Reservation>& rows) {
+    double dateRevenue = 0.0;
+    for (const Reservation& r : rows) {
+        dateRevenue += r.totalCost;
+    }
+
+    const std::string path = date + ".txt";
+    const std::string tmpPath = path + ".tmp";
+    {
+        std::ofstream outFile(tmpPath);
+        if (!outFile.is_open()) {
+            return false;
+        }
+
+        // First line: total revenue with label
+        outFile << "TOTAL_REVENUE=" << dateRevenue << "\n";
+
+        // Header line for readability
+        outFile << "GuestName,RoomNumber,RoomType,StayDate,"
+                   "Nights,CheckInHour,PricePerNight,TotalCost,BookedOn\n";
+
+        // Then each reservation with full details
+        for (const Reservation& r : rows) {
+            outFile << quoteField(r.guestName) << ","
+                    << r.roomNumber << ","
+                    << quoteField(r.roomType) << ","
+                    << r.stayDate << ","
+                    << r.nights << ","
+                    << r.checkInHour << ","
+                    << r.pricePerNight << ","
+                    << r.totalCost << ","
+                    << (r.bookedDay >= 0 ? dayNumberToDate(r.bookedDay) : "") << "\n";
+        }
+
+        if (!outFile.good()) {
+            outFile.close();
+            std::remove(tmpPath.c_str());
+            return false;
+        }
+    }
+    return std::rename(tmpPath.c_str(), path.c_str()) == 0;
+}
+
+vector<Hotel::Reservation> Hotel::mergeWithFile(const string& date,
+                                               vector<Reservation> rows,
+                                               const vector<Reservation>& removed,
+                                               vector<Reservation>& clashes) {
+    DayFile file;
+    if (parseDayFile(date + ".txt", date, file) != ParseStatus::Ok) {
+        return rows;
+    }
+
+    std::map<int, std::string> guests;   // room -> guest in memory
+    for (const Reservation& r : rows) {
+        guests.emplace(r.roomNumber, r.guestName);
+    }
+    for (Reservation& r : file.rows) {
+        bool gone = std::any_of(removed.begin(), removed.end(), [&r](const Reservation& x) {
+            return x.guestName == r.guestName && x.roomNumber == r.roomNumber &&
+                   x.stayDate == r.stayDate;
+        });
+        if (gone) continue;
+        auto room = guests.find(r.roomNumber);
+        if (room == guests.end()) {
+            guests.emplace(r.roomNumber, r.guestName);
+            rows.push_back(std::move(r));
+        }
+        else if (room->second != r.guestName) {
+            clashes.push_back(std::move(r));   // another stay holds the room in memory
+        }
+    }
+    return rows;
+}
+
+size_t Hotel::writeDates(const std::set<std::string>& dates,
+                         std::map<std::string, std::vector<Reservation>>& removed) {
+    // Dates turn dirty only once their change is published, so this view
+    // holds every change the dates were marked for
+    std::shared_ptr<const Snapshot> view = snapshot();
+
+    size_t written = 0;
+    for (const std::string& date : dates) {
+        std::vector<Reservation> rows;
+        if (const Snapshot::DayRows* stored = view->rowsFor(date)) {
+            Snapshot::RowChunks::forEach(*stored, [&rows](const Reservation& r) {
+                rows.push_back(r);
+            });
+        }
+        std::vector<Reservation> clashes;
+        rows = mergeWithFile(date, std::move(rows), removed[date], clashes);
+        if (!clashes.empty()) {
+            // Writing would drop the file's row: leave the file as it is.
+            // The date is written again once it changes.
+            for (const Reservation& r : clashes) {
+                std::cerr << "Warning: not saving " << date << ".txt: room " << r.roomNumber
+                          << " is " << r.guestName << "'s on file but another guest's in memory.\n";
+            }
+            std::lock_guard<std::mutex> lock(storeMutex);
+            std::vector<Reservation>& pending = removedRows[date];
+            pending.insert(pending.end(), removed[date].begin(), removed[date].end());
+            continue;
+        }
+
+        bool ok;
+        if (rows.empty()) {
+            // Every booking for the date was undone: drop the stale file
+            std::string path = date + ".txt";
+            ok = std::remove(path.c_str()) == 0 || errno == ENOENT;
+        }
+        else {
+            ok = writeDayFile(date, rows);
+        }
+
+        if (ok) {
+            ++written;
+            invalidateHistory(date);
+        }
+        else {
+            std::cerr << "Warning: could not save " << date
+                      << ".txt; will retry.\n";
+            std::lock_guard<std::mutex> lock(storeMutex);
+            dirtyDates.insert(date);
+            std::vector<Reservation>& pending = removedRows[date];
+            pending.insert(pending.end(), removed[date].begin(), removed[date].end());
+        }
+    }
+    return written;
+}
+
+// Write every dirty date, then forget it. Only the set of dates (and the
+// rows removed from them) is taken under storeMutex; the rows come from
+// the current snapshot and the file I/O happens without holding it.
+size_t Hotel::flushDirty() {
+    std::lock_guard<std::mutex> writeLock(flushMutex);
+
+    std::set<std::string> dates;
+    std::map<std::string, std::vector<Reservation>> removed;
+    {
+        std::lock_guard<std::mutex> lock(storeMutex);
+        dates.swap(dirtyDates);
+        for (const std::string& date : dates) {
+            auto it = removedRows.find(date);
+            if (it != removedRows.end()) {
+                removed[date] = std::move(it->second);
+                removedRows.erase(it);
+            }
+        }
+    }
+    return writeDates(dates, removed);
+}
+
+void Hotel::startBackgroundFlusher(std::chrono::milliseconds delay) {
+    if (flusherThread.joinable()) return;
+
+    stopFlusher = false;
+    flusherThread = std::thread([this, delay]() {
+        std::unique_lock<std::mutex> lock(storeMutex);
+        while (true) {
+            flushCv.wait(lock, [this]() { return stopFlusher || !dirtyDates.empty(); });
+            if (stopFlusher) break;
+
+            // Let a burst of bookings land before writing
+            flushCv.wait_for(lock, delay, [this]() { return stopFlusher; });
+
+            lock.unlock();
+            flushDirty();
+            lock.lock();
+        }
+    });
+}
+
+void Hotel::stopBackgroundFlusher() {
+    if (!flusherThread.joinable()) return;
+
+    {
+        std::lock_guard<std::mutex> lock(storeMutex);
+        stopFlusher = true;
+    }
+    flushCv.notify_one();
+    flusherThread.join();
+
+    // Whatever was still pending when the thread stopped
+    flushDirty();
+}
+
+// Parse one <date>.txt file into a standalone buffer (no hotel state touched,
+// so several files can be parsed at once on different threads)
+Hotel::ParseStatus Hotel::parseDayFile(const string& path,
+                                       const string& date,
+                                       DayFile& out) {
+    out.date = date;
+    out.totalRevenue = 0.0;
+    out.rows.clear();
+
+    std::ifstream inFile(path);
+    if (!inFile.is_open()) {
+        return ParseStatus::Missing;
+    }
+
+    std::string line;
+    if (!std::getline(inFile, line)) {
+        return ParseStatus::Empty;
+    }
+
+    // ----- Parse total revenue from first line -----
+    try {
+        if (line.rfind("TOTAL_REVENUE=", 0) == 0) {
+            std::string value = line.substr(std::string("TOTAL_REVENUE=").size());
+            out.totalRevenue = std::stod(value);
+        }
+        else if (!line.empty() && line[0] == '$') {
+            out.totalRevenue = std::stod(line.substr(1));
+        }
+        else {
+            out.totalRevenue = std::stod(line);
+        }
+    }
+    catch (...) {
+        out.totalRevenue = 0.0;
+    }
+
+    // ----- Optional header line (new format) -----
+    std::streampos posAfterFirst = inFile.tellg();
+    if (std::getline(inFile, line)) {
+        vector<string> header = split(line, ',');
+        if ((header.size() == 8 || header.size() == 9) && header[0] == "GuestName") {
+            // header -> skip
+        } else {
+            // not header, rewind
+            inFile.clear();
+            inFile.seekg(posAfterFirst);
+        }
+    }
+
+    // ----- Collect reservations from remaining lines -----
+    while (std::getline(inFile, line)) {
+        if (line.empty()) continue;
+        vector<string> parsed = splitRow(line);
+
+        // New full format. The columns after the room type are read from
+        // the right: files written before fields were quoted have room types
+        // such as "Standard Room, Scenic" split over several fields.
+        if (parsed.size() >= 8) {
+            const string& last = parsed.back();
+            const size_t tail = last.empty() || dateToDayNumber(last) >= 0 ? 6 : 5;
+            const size_t typeEnd = parsed.size() - tail;
+            if (typeEnd < 3) continue;
+
+            Reservation r;
+            try {
+                r.guestName     = parsed[0];
+                r.roomNumber    = std::stoi(parsed[1]);
+                r.roomType      = parsed[2];
+                for (size_t i = 3; i < typeEnd; ++i) r.roomType += "," + parsed[i];
+                r.stayDate      = parsed[typeEnd];
+                r.nights        = std::stoi(parsed[typeEnd + 1]);
+                r.checkInHour   = std::stoi(parsed[typeEnd + 2]);
+                r.pricePerNight = std::stod(parsed[typeEnd + 3]);
+                r.totalCost     = std::stod(parsed[typeEnd + 4]);
+            }
+            catch (...) {
+                continue; // skip bad line
+            }
+            // Optional BookedOn column (empty when not recorded)
+            if (tail == 6) {
+                r.bookedDay = dateToDayNumber(last);
+            }
+            out.rows.push_back(r);
+        }
+        // Old simple format: guestName,roomNumber
+        else if (parsed.size() >= 2) {
+            Reservation r;
+            try {
+                r.roomNumber = std::stoi(parsed[1]);
+            }
+            catch (...) {
+                continue;
+            }
+            r.guestName     = parsed[0];
+            r.roomType      = "";
+            r.stayDate      = date;
+            r.nights        = 1;
+            r.checkInHour   = 15;
+            r.pricePerNight = 0.0;
+            r.totalCost     = 0.0;
+            out.rows.push_back(r);
+        }
+    }
+
+    return ParseStatus::Ok;
+}
+
+// Requirement 16: Load reservations and revenue from file for a given date
+void Hotel::loadFromFile(const string& date) {
+    // Unsaved changes for any date go to disk before memory is reset
+    flushDirty();
+
+    // Reset state and represent only this date
+    resetStateForNewDate();
+    loadedDate = date;
+
+    int loadedDay = dateToDayNumber(date);
+    if (loadedDay >= 0) {
+        mergedEndsAfter[loadedDay] = loadedDay;
+    }
+
+    DayFile day;
+    ParseStatus status = parseDayFile(date + ".txt", date, day);
+    if (status == ParseStatus::Ok) {
+        totalRevenue = day.totalRevenue;
+    }
+
+    // ----- Restore reservations -----
+    for (const Reservation& r : day.rows) {
+        // Add to in-memory list
+        partitionRows[r.stayDate].push_back(r);
+        stalePartitions.insert(r.stayDate);
+
+        // Use stayDate as the key in reservations map
+        if (!bookRoom(r.guestName, r.stayDate, r.roomNumber, r.nights)) {
+            std::cout << "Warning: Could not restore room " << r.roomNumber
+                      << " for guest " << r.guestName << ".\n";
+        } else {
+            // Restore undo action as well
+            bookingHistory.push({ r.guestName,
+                                  r.stayDate,
+                                  r.roomNumber,
+                                  r.nights,
+                                  r.pricePerNight,
+                                  r.totalCost });
+        }
+    }
+
+    // Stays on file from earlier days that are still running today
+    if (loadedDay >= 0) {
+        mergeStaysFromDisk(loadedDay - (stayLookbackDays - 1), loadedDay - 1, loadedDay);
+    }
+
+    publishSnapshot();
+
+    if (status == ParseStatus::Missing) {
+        std::cout << "No existing reservations file found for " << date
+                  << ". Starting fresh.\n";
+        return;
+    }
+    if (status == ParseStatus::Empty) {
+        std::cout << "File for " << date << " is empty.\n";
+        return;
+    }
+
+    std::cout << "Reservations loaded from file for " << date << ".\n";
+    std::cout << "Total revenue from file: $" << totalRevenue << std::endl;
+}
+
+// Day files are merged the first time a load or a booking needs them, so
+// the calendar sees every stay on file before a room is picked and a flush
+// writes the file's rows back with the new ones. Earlier dates only need
+// the stays that run into the dates asked for; they are read again if an
+// earlier booking later needs more of them.
+bool Hotel::mergeStaysFromDisk(int firstDay, int lastDay, int endsAfter) {
+    bool added = false;
+    DayFile file;
+    for (int day = std::max(firstDay, 0); day <= lastDay; ++day) {
+        // A stay ends the day after it starts at the earliest, so any
+        // endsAfter up to the date's own day asks for the whole file
+        const int wanted = std::max(endsAfter, day);
+        auto merged = mergedEndsAfter.find(day);
+        if (merged == mergedEndsAfter.end()) {
+            merged = mergedEndsAfter.emplace(day, std::numeric_limits<int>::max()).first;
+        }
+        const int had = merged->second;
+        if (had <= wanted) continue;
+        merged->second = wanted;
+
+        const std::string date = dayNumberToDate(day);
+        auto adopt = [&](const Reservation& r) {
+            int endDay = day + std::max(r.nights, 1);
+            if (endDay <= wanted || endDay > had) return;
+            if (adoptStoredRow(r)) {
+                added = true;
+            } else {
+                std::cout << "Warning: " << date << ".txt room " << r.roomNumber
+                          << " for guest " << r.guestName
+                          << " is unknown or already taken; not loaded.\n";
+            }
+        };
+
+        forEachWorkingDayRow(date, file, adopt);
+    }
+    return added;
+}
+
+// Through the attached history's pages when it holds these files, so a
+// date looked back on by many bookings or forecasts is parsed once
+bool Hotel::forEachWorkingDayRow(const std::string& date, DayFile& buffer,
+                                 const std::function<void(const Reservation&)>& fn) {
+    if (history && historyIsWorkingDirectory) {
+        std::shared_ptr<const HistoryStore::DayPage> page = history->day(date);
+        if (!page) return false;
+        for (const Reservation& r : page->rows) fn(r);
+        return true;
+    }
+    if (parseDayFile(date + ".txt", date, buffer) != ParseStatus::Ok) return false;
+    for (const Reservation& r : buffer.rows) fn(r);
+    return true;
+}
+
+bool Hotel::adoptStoredRow(const Reservation& row) {
+    RoomTypeIt typeIt = roomTypeForRoom(row.roomNumber);
+    int startDay = dateToDayNumber(row.stayDate);
+    if (typeIt == roomTypes.end() || startDay < 0) {
+        return false;
+    }
+
+    auto dayRooms = reservations.find(row.stayDate);
+    if ((dayRooms != reservations.end() && dayRooms->second.count(row.roomNumber)) ||
+        !holdRoom(typeIt, row.roomNumber, startDay, row.nights, row.guestName)) {
+        return false;
+    }
+
+    Reservation r = row;
+    if (r.roomType.empty()) {
+        r.roomType = typeIt->first;   // legacy two-column row
+    }
+    reservations[r.stayDate][r.roomNumber] = r.guestName;
+    guestToRooms[r.guestName].push_back(r.roomNumber);
+    stalePartitions.insert(r.stayDate);
+    notifyTurnover(r, true);
+    notifyForecast(r, true);
+    partitionRows[r.stayDate].push_back(std::move(r));
+    return true;
+}
+
+// Bulk import: every <MM-DD-YYYY>.txt in a directory is parsed in parallel
+// (one local buffer per file), then all rows are merged into the
+// reservation store in a single pass sorted by (date, room).
+Hotel::ImportReport Hotel::importDirectory(const string& directory,
+                                           unsigned threadCount) {
+    namespace fs = std::filesystem;
+    using Clock = std::chrono::steady_clock;
+
+    ImportReport report;
+    Clock::time_point start = Clock::now();
+
+    // ----- Discover day files -----
+    // Importing the working directory skips the dates already merged from
+    // it; importing another one merges the working directory's files for
+    // the same dates first, so they are checked against and kept.
+    std::error_code ec;
+    const bool workingDirectory = fs::equivalent(directory, ".", ec);
+    std::vector<std::pair<std::string, fs::path>> files;   // (date, path)
+    for (fs::directory_iterator it(directory, ec), end; !ec && it != end; it.increment(ec)) {
+        if (!it->is_regular_file(ec) || it->path().extension() != ".txt") continue;
+        std::string date = it->path().stem().string();
+        int day = dateToDayNumber(date);
+        if (day < 0) continue;
+        if (workingDirectory) {
+            if (mergedEndsAfter.count(day)) {
+                mergeStaysFromDisk(day, day, day);   // already in memory, at least in part
+                continue;
+            }
+            mergedEndsAfter[day] = day;
+        } else {
+            mergeStaysFromDisk(day, day, day);
+        }
+        files.push_back({ date, it->path() });
+    }
+    if (ec) {
+        std::cout << "Unable to read directory " << directory
+                  << ": " << ec.message() << "\n";
+        return report;
+    }
+    report.filesFound = files.size();
+    if (files.empty()) {
+        std::cout << "No reservation files (MM-DD-YYYY.txt) found in "
+                  << directory << ".\n";
+        return report;
+    }
+
+    // ----- Parse in parallel, each file into its own buffer -----
+    std::vector<DayFile> parsed(files.size());
+    if (threadCount == 0) {
+        threadCount = std::max(1u, std::thread::hardware_concurrency());
+    }
+    threadCount = std::min<unsigned>(threadCount, static_cast<unsigned>(files.size()));
+
+    std::atomic<size_t> nextFile(0);
+    auto worker = [&]() {
+        for (size_t i = nextFile++; i < files.size(); i = nextFile++) {
+            parseDayFile(files[i].second.string(), files[i].first, parsed[i]);
+        }
+    };
+    std::vector<std::thread> pool;
+    for (unsigned t = 1; t < threadCount; ++t) {
+        pool.emplace_back(worker);
+    }
+    worker();
+    for (std::thread& th : pool) {
+        th.join();
+    }
+
+    Clock::time_point parsedAt = Clock::now();
+    report.parseMillis = std::chrono::duration<double, std::milli>(parsedAt - start).count();
+
+    // ----- Flatten and sort by (stay date, room) -----
+    struct Row {
+        int day;
+        Reservation* r;
+    };
+    std::vector<Row> rows;
+    for (DayFile& file : parsed) {
+        report.rowsParsed += file.rows.size();
+    }
+    rows.reserve(report.rowsParsed);
+    for (DayFile& file : parsed) {
+        for (Reservation& r : file.rows) {
+            rows.push_back({ dateToDayNumber(r.stayDate), &r });
+        }
+    }
+    std::sort(rows.begin(), rows.end(), [](const Row& a, const Row& b) {
+        if (a.day != b.day) return a.day < b.day;
+        if (a.r->roomNumber != b.r->roomNumber) return a.r->roomNumber < b.r->roomNumber;
+        return a.r->guestName < b.r->guestName;
+    });
+
+    // room number -> room type, for validating and filling legacy rows
+    std::unordered_map<int, const std::string*> roomIndex;
+    for (const auto& p : roomTypes) {
+        for (int room : p.second.allRoomNumbers) {
+            roomIndex[room] = &p.first;
+        }
+    }
+
+    // Stays over the loaded date (if any) also take today's rooms
+    const int loadedDay = dateToDayNumber(loadedDate);
+
+    // ----- Merge in one pass -----
+    RoomGuests* dayRooms = nullptr;
+    Snapshot::RowChunks* dayRows = nullptr;
+    int currentDay = -1;
+
+    for (const Row& row : rows) {
+        Reservation& r = *row.r;
+
+        if (row.day < 0) {
+            report.conflicts.push_back("Invalid stay date '" + r.stayDate +
+                                       "' for guest " + r.guestName);
+            continue;
+        }
+
+        auto roomIt = roomIndex.find(r.roomNumber);
+        if (roomIt == roomIndex.end()) {
+            report.conflicts.push_back(r.stayDate + " room " + std::to_string(r.roomNumber) +
+                                       ": unknown room for guest " + r.guestName);
+            continue;
+        }
+        if (r.roomType.empty()) {
+            r.roomType = *roomIt->second;   // legacy two-column row
+        }
+
+        if (row.day != currentDay) {
+            dayRooms = &reservations[r.stayDate];
+            dayRows = &partitionRows[r.stayDate];
+            currentDay = row.day;
+        }
+
+        auto existing = dayRooms->find(r.roomNumber);
+        if (existing != dayRooms->end()) {
+            report.conflicts.push_back(r.stayDate + " room " + std::to_string(r.roomNumber) +
+                                       ": double-booked (" + existing->second +
+                                       " and " + r.guestName + "), kept " + existing->second);
+            continue;
+        }
+
+        int endDay = row.day + std::max(r.nights, 1);
+        if (!calendar.isFree(r.roomNumber, row.day, endDay)) {
+            report.conflicts.push_back(r.stayDate + " room " + std::to_string(r.roomNumber) +
+                                       ": double-booked (overlaps an earlier multi-night stay), skipped " +
+                                       r.guestName);
+            continue;
+        }
+
+        if (loadedDay >= 0 && coversLoadedDay(row.day, r.nights)) {
+            // Today's rooms also come out of availability
+            if (!bookRoom(r.guestName, r.stayDate, r.roomNumber, r.nights)) {
+                report.conflicts.push_back(r.stayDate + " room " + std::to_string(r.roomNumber) +
+                                           ": not available for " + r.guestName);
+                continue;
+            }
+            if (r.stayDate == loadedDate) {
+                totalRevenue += r.totalCost;
+            }
+        }
+        else {
+            dayRooms->emplace_hint(dayRooms->end(), r.roomNumber, r.guestName);
+            guestToRooms[r.guestName].push_back(r.roomNumber);
+            guestHistory.push_back(r.guestName);
+            guestLog.push_back(r.guestName);
+            calendar.book(r.roomNumber, row.day, endDay);
+        }
+        changedDates.insert(r.stayDate);
+        stalePartitions.insert(r.stayDate);
+        notifyTurnover(r, true);
+        notifyForecast(r, true);
+        dayRows->push_back(std::move(r));
+        ++report.imported;
+    }
+
+    // Dates that only had conflicting rows should not leave empty entries
+    for (auto it = reservations.begin(); it != reservations.end();) {
+        if (it->second.empty()) it = reservations.erase(it);
+        else ++it;
+    }
+    for (auto it = partitionRows.begin(); it != partitionRows.end();) {
+        if (it->second.size() == 0) it = partitionRows.erase(it);
+        else ++it;
+    }
+    publishSnapshot();
+
+    report.mergeMillis = std::chrono::duration<double, std::milli>(Clock::now() - parsedAt).count();
+
+    std::cout << "Imported " << report.imported << " of " << report.rowsParsed
+              << " reservations from " << report.filesFound << " files in "
+              << directory << " (" << threadCount << " threads, parse "
+              << report.parseMillis << " ms, merge " << report.mergeMillis << " ms).\n";
+    if (!report.conflicts.empty()) {
+        const size_t shown = std::min<size_t>(report.conflicts.size(), 20);
+        std::cout << report.conflicts.size() << " conflicts:\n";
+        for (size_t i = 0; i < shown; ++i) {
+            std::cout << "  " << report.conflicts[i] << "\n";
+        }
+        if (shown < report.conflicts.size()) {
+            std::cout << "  ... and " << (report.conflicts.size() - shown) << " more\n";
+        }
+    }
+    return report;
+}
+
+// Requirement 17: Show reservations for a specific date
+void Hotel::showReservationsForDate(const std::string& date) {
+    std::shared_ptr<const Snapshot> view = snapshot();
+    const Snapshot::DayRows* rows = view->rowsFor(date);
+
+    // Rows are in booking order; list them by room
+    std::vector<const Reservation*> byRoom;
+    std::shared_ptr<const HistoryStore::DayPage> page;
+    if (rows) {
+        Snapshot::RowChunks::forEach(*rows, [&byRoom](const Reservation& r) {
+            byRoom.push_back(&r);
+        });
+    }
+    else if (history && (page = history->day(date))) {
+        for (const Reservation& r : page->rows) byRoom.push_back(&r);
+    }
+
+    if (byRoom.empty()) {
+        std::cout << "No reservations found for " << date << ".\n";
+        return;
+    }
+    std::sort(byRoom.begin(), byRoom.end(), [](const Reservation* a, const Reservation* b) {
+        return a->roomNumber < b->roomNumber;
+    });
+
+    std::cout << "Reservations for " << date << (page ? " (on file)" : "") << ":\n";
+    for (const Reservation* r : byRoom) {
+        std::cout << "  Room " << r->roomNumber
+                  << ": " << r->guestName << std::endl;
+    }
+}
+
+// Hash table lookup
+void Hotel::findGuestReservations(const std::string& guestName) {
+    auto it = guestToRooms.find(guestName);
+    if (it != guestToRooms.end()) {
+        std::cout << "Rooms reserved for " << guestName << ": ";
+        for (size_t i = 0; i < it->second.size(); ++i) {
+            if (i > 0) std::cout << ", ";
+            std::cout << it->second[i];
+        }
+        std::cout << "\n";
+    }
+
+    // Stays on file, except for dates held in memory (which may be newer)
+    size_t onFile = 0;
+    if (history) {
+        std::shared_ptr<const Snapshot> view = snapshot();
+        for (const HistoryStore::GuestStay& stay : history->findGuest(guestName)) {
+            if (view->rowsFor(stay.date)) continue;
+            if (onFile++ == 0) std::cout << "Stays on file for " << guestName << ":\n";
+            std::cout << "  " << stay.date << "  Room " << stay.roomNumber
+                      << "  (" << stay.nights << " night" << (stay.nights == 1 ? "" : "s") << ")\n";
+        }
+    }
+
+    if (it == guestToRooms.end() && onFile == 0) {
+        std::cout << "No reservations found for " << guestName << ".\n";
+    }
+}
+
+void Hotel::attachHistory(const std::string& directory, size_t budgetBytes) {
+    std::error_code ec;
+    history.reset(new HistoryStore(directory, budgetBytes));
+    historyIsWorkingDirectory = std::filesystem::equivalent(directory, ".", ec);
+}
+
+void Hotel::invalidateHistory(const std::string& date) {
+    if (history) history->invalidate(date);
+}
+
+// Undo last booking (stack)
+bool Hotel::undoLastBooking() {
+    if (bookingHistory.empty()) {
+        std::cout << "No bookings to undo.\n";
+        return false;
+    }
+
+    Action last = bookingHistory.top();
+    bookingHistory.pop();
+
+    // Find room type that contains this room number
+    RoomTypeIt typeIt = roomTypeForRoom(last.roomNumber);
+    RoomType* foundType = typeIt != roomTypes.end() ? &typeIt->second : nullptr;
+
+    if (!foundType) {
+        std::cout << "Error: Could not find room type for room "
+                  << last.roomNumber << ". Undo failed.\n";
+        return false;
+    }
+
+    // Adjust revenue by full cost of this booking
+    totalRevenue -= last.totalCost;
+    if (totalRevenue < 0) totalRevenue = 0;
+
+    int startDay = dateToDayNumber(last.date);
+    bool heldToday = coversLoadedDay(startDay, last.nights);
+    if (heldToday) {
+        // Remove guest from room's guest map
+        foundType->guests.erase(last.roomNumber);
+
+        // Return room to availability (avoid duplicates)
+        if (std::find(foundType->availableRoomNumbers.begin(),
+                      foundType->availableRoomNumbers.end(),
+                      last.roomNumber) == foundType->availableRoomNumbers.end()) {
+            foundType->availableRoomNumbers.push_back(last.roomNumber);
+            foundType->availableRooms++;
+        }
+    }
+    if (startDay >= 0) {
+        calendar.release(last.roomNumber, startDay, startDay + std::max(last.nights, 1));
+    }
+
+    // Remove from reservations map
+    auto dateIt = reservations.find(last.date);
+    if (dateIt != reservations.end()) {
+        dateIt->second.erase(last.roomNumber);
+        if (dateIt->second.empty()) {
+            reservations.erase(dateIt);
+        }
+    }
+
+    // Remove from people/roomsnums (last matching)
+    for (int i = static_cast<int>(people.size()) - 1; i >= 0; --i) {
+        if (people[i] == last.guestName && roomsnums[i] == last.roomNumber) {
+            people.erase(people.begin() + i);
+            roomsnums.erase(roomsnums.begin() + i);
+            sessionLog.erase(static_cast<size_t>(i));
+            break;
+        }
+    }
+
+    // Remove from the stored rows (last matching one)
+    auto dayIt = partitionRows.find(last.date);
+    if (dayIt != partitionRows.end()) {
+        Snapshot::RowChunks& rows = dayIt->second;
+        for (size_t i = rows.size(); i-- > 0;) {
+            const Reservation& r = rows.at(i);
+            if (r.guestName == last.guestName && r.roomNumber == last.roomNumber) {
+                notifyTurnover(r, false);
+                notifyForecast(r, false);
+                removedSincePublish.push_back(r);
+                rows.erase(i);
+                break;
+            }
+        }
+        if (rows.size() == 0) {
+            partitionRows.erase(dayIt);
+        }
+    }
+    changedDates.insert(last.date);
+    stalePartitions.insert(last.date);
+
+    // Remove from guest history (remove one occurrence from back)
+    size_t position = guestHistory.size();
+    for (auto it = guestHistory.end(); it != guestHistory.begin();) {
+        --it;
+        --position;
+        if (*it == last.guestName) {
+            guestHistory.erase(it);
+            guestLog.erase(position);
+            break;
+        }
+    }
+
+    // Remove from hash table guestToRooms
+    auto git = guestToRooms.find(last.guestName);
+    if (git != guestToRooms.end()) {
+        auto& vec = git->second;
+        vec.erase(std::remove(vec.begin(), vec.end(), last.roomNumber), vec.end());
+        if (vec.empty()) {
+            guestToRooms.erase(git);
+        }
+    }
+
+    // Remove from tree
+    if (heldToday) {
+        occupiedRoomsRoot = removeRoomFromTree(occupiedRoomsRoot, last.roomNumber);
+    }
+
+    publishSnapshot();
+
+    std::cout << "Booking for " << last.guestName
+              << " in room " << last.roomNumber
+              << " on " << last.date << " has been undone.\n";
+    return true;
+}
+
+// Show occupied rooms via tree traversal
+void Hotel::displayOccupiedRoomsInOrder() {
+    if (!occupiedRoomsRoot) {
+        std::cout << "No occupied rooms yet.\n";
+        return;
+    }
+    std::cout << "Occupied rooms (in-order from tree): ";
+    inorderPrint(occupiedRoomsRoot);
+    std::cout << "\n";
+}
+
+// Graph traversal (BFS using roomGraph and std::queue)
+void Hotel::bfsFromRoom(int startRoom) {
+    const int* neighbors = nullptr;
+    size_t neighborCount = 0;
+    if (!roomNeighbors(startRoom, neighbors, neighborCount)) {
+        std::cout << "Room " << startRoom << " not found in hotel graph.\n";
+        return;
+    }
+
+    std::set<int> visited;
+    std::queue<int> q;  // Requirement: Queue
+
+    q.push(startRoom);
+    visited.insert(startRoom);
+
+    std::cout << "BFS starting from room " << startRoom << ": ";
+    bool first = true;
+
+    while (!q.empty()) {
+        int r = q.front();
+        q.pop();
+
+        if (!first) std::cout << " -> ";
+        std::cout << r;
+        first = false;
+
+        roomNeighbors(r, neighbors, neighborCount);
+        for (size_t i = 0; i < neighborCount; ++i) {
+            int neighbor = neighbors[i];
+            if (visited.find(neighbor) == visited.end()) {
+                visited.insert(neighbor);
+                q.push(neighbor);
+            }
+        }
+    }
+    std::cout << "\n";
+}
+
+// List guest history
+void Hotel::showGuestHistory() {
+    std::shared_ptr<const Snapshot> view = snapshot();
+    if (view->guestHistory.empty()) {
+        std::cout << "No guest history yet.\n";
+        return;
+    }
+    std::cout << "Guest reservation history (in order):\n";
+    Snapshot::NameChunks::forEach(view->guestHistory, [](const std::string& name) {
+        std::cout << "  " << name << "\n";
+    });
+}
+
+std::shared_ptr<const Hotel::Snapshot> Hotel::snapshot() const {
+    return std::atomic_load(&published);
+}
+
+// Freeze the partitions of the dates touched since the last publish, share
+// everything else, and swap the new snapshot in. Readers holding the old
+// one keep it alive until they drop it.
+void Hotel::publishSnapshot() {
+    auto next = std::make_shared<Snapshot>();
+    next->version = ++snapshotVersion;
+    next->loadedDate = loadedDate;
+    next->totalRevenue = totalRevenue;
+
+    next->roomTypes.reserve(roomTypes.size());
+    for (const auto& rt : roomTypes) {
+        next->roomTypes.push_back({ rt.first, rt.second.totalRooms, rt.second.availableRooms,
+                                    rt.second.pricePerNight, rt.second.roomRange });
+    }
+
+    if (!stalePartitions.empty() || !publishedDays) {
+        std::set<std::string> staleMonths;
+        for (const std::string& date : stalePartitions) {
+            std::string month = Snapshot::monthOf(date);
+            staleMonths.insert(month);
+            auto it = partitionRows.find(date);
+            if (it == partitionRows.end() || it->second.size() == 0) {
+                frozenDays[month].erase(date);
+            }
+            else {
+                frozenDays[month][date] = std::make_shared<const Snapshot::DayRows>(it->second.freeze());
+            }
+        }
+        stalePartitions.clear();
+
+        for (const std::string& month : staleMonths) {
+            const auto& days = frozenDays[month];
+            if (days.empty()) {
+                frozenDays.erase(month);
+                frozenMonths.erase(month);
+            }
+            else {
+                frozenMonths[month] = std::make_shared<const Snapshot::MonthDays>(days.begin(), days.end());
+            }
+        }
+        publishedDays = std::make_shared<const Snapshot::DayIndex>(frozenMonths.begin(), frozenMonths.end());
+    }
+    next->days = publishedDays;
+    next->sessionBookings = sessionLog.freeze();
+    next->guestHistory = guestLog.freeze();
+
+    std::atomic_store(&published, std::shared_ptr<const Snapshot>(std::move(next)));
+
+    // The flusher reads rows from snapshot(), so dates turn dirty only now
+    if (!changedDates.empty()) {
+        {
+            std::lock_guard<std::mutex> lock(storeMutex);
+            dirtyDates.insert(changedDates.begin(), changedDates.end());
+            for (Reservation& r : removedSincePublish) {
+                removedRows[r.stayDate].push_back(std::move(r));
+            }
+        }
+        changedDates.clear();
+        removedSincePublish.clear();
+        flushCv.notify_one();
+    }
+}
+
+template <class Node>
+static size_t countNodes(const Node* node) {
+    return node ? 1 + countNodes(node->left) + countNodes(node->right) : 0;
+}
+
+// std::stack keeps its container protected; this reads it without a copy
+template <class Stack>
+struct StackContents : Stack {
+    static const typename Stack::container_type& of(const Stack& s) {
+        return s.*(&StackContents::c);
+    }
+};
+
+Hotel::MemoryReport Hotel::memoryReport() const {
+    MemoryReport report;
+    auto add = [&report](MemoryArea area, size_t elements, long long stringBytes) {
+        const MemoryCounter& counter = memoryCounter(area);
+        MemoryUsage usage;
+        usage.structure = memoryAreaName(area);
+        usage.elements = elements;
+        usage.bytes = counter.bytes.load(std::memory_order_relaxed);
+        usage.peakBytes = counter.peakBytes.load(std::memory_order_relaxed);
+        usage.stringBytes = stringBytes;
+        report.structures.push_back(usage);
+        report.totalBytes += stringBytes;
+    };
+    auto rowBytes = [](const Reservation& r) {
+        return heapBytes(r.guestName) + heapBytes(r.roomType) + heapBytes(r.stayDate);
+    };
+
+    long long strings = 0;
+    for (const std::string& guest : people) strings += heapBytes(guest);
+    add(MemoryArea::People, people.size(), strings);
+
+    add(MemoryArea::RoomNumbers, roomsnums.size(), 0);
+
+    size_t entries = 0;
+    strings = 0;
+    for (const auto& day : reservations) {
+        strings += heapBytes(day.first);
+        for (const auto& room : day.second) strings += heapBytes(room.second);
+        entries += day.second.size();
+    }
+    add(MemoryArea::Reservations, entries, strings);
+
+    entries = 0;
+    strings = 0;
+    for (const auto& guest : guestToRooms) {
+        strings += heapBytes(guest.first);
+        entries += guest.second.size();
+    }
+    add(MemoryArea::GuestToRooms, entries, strings);
+
+    strings = 0;
+    for (const std::string& guest : guestHistory) strings += heapBytes(guest);
+    add(MemoryArea::GuestHistory, guestHistory.size(), strings);
+
+    add(MemoryArea::OccupiedTree, countNodes(occupiedRoomsRoot), 0);
+
+    strings = 0;
+    for (const Action& action : StackContents<decltype(bookingHistory)>::of(bookingHistory)) {
+        strings += heapBytes(action.guestName) + heapBytes(action.date);
+    }
+    add(MemoryArea::BookingHistory, bookingHistory.size(), strings);
+
+    entries = 0;
+    strings = 0;
+    for (const auto& type : roomTypes) {
+        for (const auto& room : type.second.guests) strings += heapBytes(room.second);
+        entries += type.second.guests.size();
+    }
+    add(MemoryArea::RoomGuests, entries, strings);
+
+    add(MemoryArea::Calendar, calendar.bookingCount(), 0);
+
+    // Chunks the current state holds (older snapshots may still pin others)
+    entries = sessionLog.size() + guestLog.size();
+    strings = 0;
+    for (const auto& day : partitionRows) {
+        entries += day.second.size();
+        strings += heapBytes(day.first);
+        day.second.forEachLive([&](const Reservation& r) { strings += rowBytes(r); });
+    }
+    Snapshot::SessionChunks::forEach(sessionLog.freeze(), [&](const Snapshot::SessionBooking& b) {
+        strings += heapBytes(b.guestName);
+    });
+    Snapshot::NameChunks::forEach(guestLog.freeze(), [&](const std::string& guest) {
+        strings += heapBytes(guest);
+    });
+    add(MemoryArea::SnapshotChunks, entries, strings);
+
+    HistoryStore::Stats cached = history ? history->stats() : HistoryStore::Stats();
+    add(MemoryArea::HistoryCache, cached.residentRows, cached.residentStringBytes);
+
+    report.totalBytes += memoryTotal.bytes.load(std::memory_order_relaxed);
+    report.peakContainerBytes = memoryTotal.peakBytes.load(std::memory_order_relaxed);
+    return report;
+}
+
+void Hotel::showMemoryUsage() const {
+    MemoryReport report = memoryReport();
+    std::cout << "\nMemory by structure (bytes; container counters are process-wide):\n";
+    std::cout << "  " << std::left << std::setw(20) << "structure" << std::right
+              << std::setw(10) << "elements" << std::setw(12) << "bytes"
+              << std::setw(12) << "peak" << std::setw(12) << "strings" << "\n";
+    for (const MemoryUsage& usage : report.structures) {
+        std::cout << "  " << std::left << std::setw(20) << usage.structure << std::right
+                  << std::setw(10) << usage.elements << std::setw(12) << usage.bytes
+                  << std::setw(12) << usage.peakBytes << std::setw(12) << usage.stringBytes << "\n";
+    }
+    std::cout << "  Total: " << report.totalBytes << " bytes (containers peaked at "
+              << report.peakContainerBytes << ")\n";
+}
+
+// Columnar export straight from a published snapshot: days come out of the
+// month index in date order and only the writer's current row group is
+// buffered, so this runs alongside bookings without copying the store.
+Hotel::ExportReport Hotel::exportColumnar(const string& path, size_t rowGroupRows) const {
+    using Clock = std::chrono::steady_clock;
+    Clock::time_point start = Clock::now();
+    std::shared_ptr<const Snapshot> view = snapshot();
+
+    ExportReport report;
+    ColumnarWriter writer(path, rowGroupRows);
+    if (view && view->days) {
+        for (const auto& month : *view->days) {
+            for (const auto& day : *month.second) {
+                Snapshot::RowChunks::forEach(*day.second, [&writer](const Reservation& r) {
+                    writer.append(r);
+                });
+            }
+        }
+    }
+    report.rows = writer.rowsWritten();
+    report.ok = writer.close();
+    report.error = writer.lastError();
+    report.rowGroups = writer.rowGroupsWritten();
+    std::error_code ec;
+    if (report.ok) report.bytes = std::filesystem::file_size(path, ec);
+    report.millis = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+    return report;
+}
+
+// Same file layout as exportColumnar, built from day files on disk. Files are
+// parsed one at a time, so memory stays at one day plus one row group.
+Hotel::ExportReport Hotel::exportDirectoryColumnar(const string& directory,
+                                                   const string& path,
+                                                   size_t rowGroupRows) {
+    namespace fs = std::filesystem;
+    using Clock = std::chrono::steady_clock;
+    Clock::time_point start = Clock::now();
+
+    ExportReport report;
+    std::vector<std::pair<int, fs::path>> files;   // (day number, path)
+    std::error_code ec;
+    for (fs::directory_iterator it(directory, ec), end; !ec && it != end; it.increment(ec)) {
+        if (!it->is_regular_file(ec) || it->path().extension() != ".txt") continue;
+        int day = dateToDayNumber(it->path().stem().string());
+        if (day < 0) continue;
+        files.push_back({ day, it->path() });
+    }
+    if (ec) {
+        report.error = "unable to read directory " + directory + ": " + ec.message();
+        return report;
+    }
+    std::sort(files.begin(), files.end());
+
+    ColumnarWriter writer(path, rowGroupRows);
+    DayFile day;
+    for (const auto& file : files) {
+        if (parseDayFile(file.second.string(), file.second.stem().string(), day) != ParseStatus::Ok) continue;
+        ++report.filesRead;
+        for (const Reservation& r : day.rows) writer.append(r);
+    }
+    report.rows = writer.rowsWritten();
+    report.ok = writer.close();
+    report.error = writer.lastError();
+    report.rowGroups = writer.rowGroupsWritten();
+    if (report.ok) report.bytes = fs::file_size(path, ec);
+    report.millis = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+    return report;
+}
+
+void Hotel::showColumnarScan(const string& path, const string& fromDate, const string& toDate) {
+    int fromDay = dateToDayNumber(fromDate);
+    int toDay = dateToDayNumber(toDate);
+    if (fromDay < 0 || toDay < 0) {
+        std::cout << "Dates must be MM-DD-YYYY.\n";
+        return;
+    }
+
+    ColumnarReader reader(path);
+    if (!reader.ok()) {
+        std::cout << "Unable to open columnar file: " << reader.lastError() << "\n";
+        return;
+    }
+
+    const size_t maxPrinted = 50;
+    size_t printed = 0;
+    ColumnarReader::ScanStats stats = reader.scan(fromDay, toDay, [&](const Reservation& r) {
+        if (printed++ >= maxPrinted) return;
+        std::cout << "  " << r.stayDate << "  Room " << r.roomNumber << " (" << r.roomType << ")  "
+                  << r.guestName << ", " << r.nights << " night(s), $" << r.totalCost << "\n";
+    });
+    if (!reader.ok()) {
+        std::cout << "Read error: " << reader.lastError() << "\n";
+        return;
+    }
+    if (stats.rowsMatched > maxPrinted) {
+        std::cout << "  ... " << (stats.rowsMatched - maxPrinted) << " more\n";
+    }
+    std::cout << "Reservations from " << fromDate << " to " << toDate << ": " << stats.rowsMatched
+              << ", revenue $" << stats.revenue << "\n";
+    std::cout << "Row groups read: " << stats.groupsRead << " of " << reader.rowGroups().size()
+              << " (" << stats.groupsSkipped << " skipped by date statistics)\n";
+}
+
+void Hotel::applyRoomMoves(const std::vector<RoomMove>& moves) {
+    if (moves.empty()) return;
+
+    // The session lists and undo stack are matched on the old room, all at
+    // once, so a chain of moves (A: 101 -> 102, B: 102 -> 103) resolves
+    // against the rooms before the batch
+    std::map<std::pair<std::string, int>, std::vector<int>> sessionMoves;   // (guest, old) -> new
+    std::map<std::pair<std::string, std::pair<std::string, int>>, int> undoMoves;
+
+    for (const RoomMove& move : moves) {
+        Snapshot::RowChunks& rows = partitionRows[move.date];
+        Reservation r = rows.at(move.row);
+        const int oldRoom = r.roomNumber;
+        const int newRoom = move.newRoom;
+        Reservation before = r;
+
+        auto dateIt = reservations.find(r.stayDate);
+        if (dateIt != reservations.end()) {
+            auto roomIt = dateIt->second.find(oldRoom);
+            if (roomIt != dateIt->second.end() && roomIt->second == r.guestName) {
+                dateIt->second.erase(roomIt);
+            }
+        }
+        auto guestIt = guestToRooms.find(r.guestName);
+        if (guestIt != guestToRooms.end()) {
+            auto roomIt = std::find(guestIt->second.begin(), guestIt->second.end(), oldRoom);
+            if (roomIt != guestIt->second.end()) *roomIt = newRoom;
+        }
+        sessionMoves[{ r.guestName, oldRoom }].push_back(newRoom);
+        undoMoves[{ r.guestName, { r.stayDate, oldRoom } }] = newRoom;
+
+        removedSincePublish.push_back(before);
+        r.roomNumber = newRoom;
+        changedDates.insert(r.stayDate);
+        stalePartitions.insert(r.stayDate);
+        rows.set(move.row, r);
+        notifyTurnover(before, false);
+        notifyTurnover(r, true);
+    }
+    // Second pass so a room vacated by one move and taken by another ends
+    // up with its new guest
+    for (const RoomMove& move : moves) {
+        reservations[move.date][move.newRoom] = partitionRows[move.date].at(move.row).guestName;
+    }
+
+    for (size_t i = 0; i < people.size(); ++i) {
+        auto it = sessionMoves.find({ people[i], roomsnums[i] });
+        if (it == sessionMoves.end() || it->second.empty()) continue;
+        roomsnums[i] = it->second.back();
+        sessionLog.set(i, { people[i], roomsnums[i] });
+        it->second.pop_back();
+    }
+
+    // Undo must release the room the stay now holds
+    std::vector<Action> actions;
+    while (!bookingHistory.empty()) {
+        actions.push_back(bookingHistory.top());
+        bookingHistory.pop();
+    }
+    for (auto it = actions.rbegin(); it != actions.rend(); ++it) {
+        auto moved = undoMoves.find({ it->guestName, { it->date, it->roomNumber } });
+        if (moved != undoMoves.end()) it->roomNumber = moved->second;
+        bookingHistory.push(*it);
+    }
+}
+
+// Nightly re-optimization. For each room type, the unlocked stays (arriving
+// after asOfDate and not holding one of today's rooms) are lifted out of
+// the calendar and packed back longest-first with best fit, each stay
+// preferring its current room on ties. The new layout is kept only if every
+// stay still fits and long-stay capacity goes up.
+Hotel::ReoptimizeReport Hotel::reoptimizeAssignments(const std::string& asOfDate) {
+    ReoptimizeReport report;
+    int asOf = dateToDayNumber(asOfDate);
+    if (asOf < 0) {
+        std::cout << "Invalid date " << asOfDate << ". Use MM-DD-YYYY.\n";
+        return report;
+    }
+
+    struct Stay {
+        const std::string* date;
+        size_t row;
+        int room;
+        int start;
+        int end;
+        int newRoom;
+    };
+
+    // Every stay on file that holds a room after asOfDate must be in the
+    // calendar before any stay is lifted, or a stay could be moved onto a
+    // room that a stay never loaded holds. Merged stays can reach further
+    // out, so repeat until the horizon stops growing.
+    bool merged = false;
+    while (true) {
+        int horizonEnd = asOf + 1;
+        for (const auto& day : partitionRows) {
+            int start = dateToDayNumber(day.first);
+            if (start <= asOf) continue;
+            day.second.forEachLive([&](const Reservation& r) {
+                horizonEnd = std::max(horizonEnd, start + std::max(r.nights, 1));
+            });
+        }
+        horizonEnd += calendar.longStayThreshold();
+        if (!mergeStaysFromDisk(asOf + 1 - (stayLookbackDays - 1), horizonEnd - 1, asOf)) break;
+        merged = true;
+    }
+
+    std::vector<RoomMove> moves;
+    for (RoomTypeIt typeIt = roomTypes.begin(); typeIt != roomTypes.end(); ++typeIt) {
+        const std::vector<int>& rooms = typeIt->second.allRoomNumbers;
+
+        std::vector<Stay> stays;
+        int horizonEnd = asOf + 1;
+        for (const auto& day : partitionRows) {
+            int start = dateToDayNumber(day.first);
+            if (start <= asOf) continue;
+            size_t row = 0;
+            day.second.forEachLive([&](const Reservation& r) {
+                int end = start + std::max(r.nights, 1);
+                if (!coversLoadedDay(start, r.nights) && roomTypeForRoom(r.roomNumber) == typeIt) {
+                    stays.push_back({ &day.first, row, r.roomNumber, start, end, -1 });
+                    horizonEnd = std::max(horizonEnd, end);
+                }
+                ++row;
+            });
+        }
+        if (stays.empty()) continue;
+        report.staysConsidered += stays.size();
+
+        horizonEnd += calendar.longStayThreshold();
+        long before = calendar.longStayCapacity(rooms, asOf + 1, horizonEnd);
+        report.capacityBefore += before;
+
+        for (const Stay& s : stays) {
+            calendar.release(s.room, s.start, s.end);
+        }
+
+        // Longest stays first, then earliest arrival
+        std::vector<Stay*> order;
+        for (Stay& s : stays) order.push_back(&s);
+        std::stable_sort(order.begin(), order.end(), [](const Stay* a, const Stay* b) {
+            if (a->end - a->start != b->end - b->start) return a->end - a->start > b->end - b->start;
+            return a->start < b->start;
+        });
+
+        bool packed = true;
+        std::vector<int> candidates;
+        candidates.reserve(rooms.size() + 1);
+        for (Stay* s : order) {
+            candidates.assign(1, s->room);
+            candidates.insert(candidates.end(), rooms.begin(), rooms.end());
+            s->newRoom = calendar.bestFit(candidates, s->start, s->end);
+            if (s->newRoom < 0) {
+                packed = false;
+                break;
+            }
+            calendar.book(s->newRoom, s->start, s->end);
+        }
+
+        long after = packed ? calendar.longStayCapacity(rooms, asOf + 1, horizonEnd) : -1;
+        if (!packed || after <= before) {
+            // Put every stay back where it was
+            for (const Stay& s : stays) {
+                if (s.newRoom >= 0) calendar.release(s.newRoom, s.start, s.end);
+            }
+            for (const Stay& s : stays) {
+                calendar.book(s.room, s.start, s.end);
+            }
+            report.capacityAfter += before;
+            continue;
+        }
+
+        report.capacityAfter += after;
+        for (const Stay& s : stays) {
+            if (s.newRoom != s.room) moves.push_back({ *s.date, s.row, s.newRoom });
+        }
+    }
+
+    applyRoomMoves(moves);
+    if (merged || !moves.empty()) publishSnapshot();
+    report.staysMoved = moves.size();
+
+    std::cout << "Re-optimized " << report.staysConsidered << " future stays after "
+              << asOfDate << ": " << report.staysMoved << " moved. "
+              << "Long-stay capacity " << report.capacityBefore << " -> "
+              << report.capacityAfter << " room-nights.\n";
+    return report;
+}
+
+void Hotel::notifyTurnover(const Reservation& r, bool added) {
+    if (!turnover) return;
+    int arrivalDay = dateToDayNumber(r.stayDate);
+    if (arrivalDay < 0) return;
+    if (added) {
+        turnover->addStay(r.guestName, r.roomNumber, arrivalDay, r.nights, r.checkInHour);
+    }
+    else {
+        turnover->removeStay(r.guestName, r.roomNumber, arrivalDay, r.nights, r.checkInHour);
+    }
+}
+
+std::string Hotel::forecastRowKey(const Reservation& r) {
+    return r.stayDate + '\t' + std::to_string(r.roomNumber) + '\t' + r.guestName;
+}
+
+void Hotel::notifyForecast(const Reservation& r, bool added) {
+    if (!forecaster) return;
+    if (added && !forecastFileRows.empty() && forecastFileRows.erase(forecastRowKey(r))) {
+        return;   // read from its file when the forecast was built
+    }
+    int arrivalDay = dateToDayNumber(r.stayDate);
+    if (added) {
+        forecaster->addStay(r.roomType, arrivalDay, r.nights, r.bookedDay, r.totalCost);
+    }
+    else {
+        forecaster->removeStay(r.roomType, arrivalDay, r.nights, r.bookedDay, r.totalCost);
+    }
+}
+
+// Housekeeping turnover plan. The first request for a date makes one pass
+// over the stored reservations; after that bookings and undos update the
+// plan incrementally and only the floors they touch are re-routed.
+void Hotel::showTurnoverPlan(const std::string& date, int housekeepers) {
+    int day = dateToDayNumber(date);
+    if (day < 0) {
+        std::cout << "Invalid date " << date << ". Use MM-DD-YYYY.\n";
+        return;
+    }
+
+    // The date's arrivals, and stays on file from earlier days that check
+    // out on it or run through it
+    if (mergeStaysFromDisk(day - (stayLookbackDays - 1), day, day - 1)) {
+        publishSnapshot();
+    }
+
+    bool rebuilt = false;
+    if (!turnover || turnover->day() != day ||
+        turnover->housekeepers() != std::max(1, housekeepers)) {
+        turnover.reset(new TurnoverScheduler(day, housekeepers,
+            [this](int room, const int*& first, size_t& count) {
+                return roomNeighbors(room, first, count);
+            }));
+        for (const auto& dayRows : partitionRows) {
+            dayRows.second.forEachLive([this](const Reservation& r) { notifyTurnover(r, true); });
+        }
+        rebuilt = true;
+    }
+
+    const std::vector<TurnoverScheduler::HousekeeperRoute>& routes = turnover->plan();
+
+    static const char* const kindNames[] = { "turnover ", "arrival  ", "departure" };
+    std::cout << "\nTurnover plan for " << date << " ("
+              << (rebuilt ? "built" : "updated") << ", "
+              << turnover->lastReplannedFloors() << " floors routed):\n";
+
+    size_t totalTasks = 0;
+    for (const TurnoverScheduler::HousekeeperRoute& route : routes) {
+        std::cout << "Housekeeper " << route.housekeeper << " - floors:";
+        if (route.floors.empty()) std::cout << " none";
+        for (int floor : route.floors) std::cout << " " << floor;
+        std::cout << "\n";
+
+        for (const TurnoverScheduler::Task& task : route.tasks) {
+            std::cout << "  Room " << task.roomNumber << "  " << kindNames[task.kind];
+            if (task.readyByHour < 24) {
+                std::cout << "  ready by " << task.readyByHour << ":00";
+            } else {
+                std::cout << "  no check-in  ";
+            }
+            if (!task.departingGuest.empty()) std::cout << "  out: " << task.departingGuest;
+            if (!task.arrivingGuest.empty()) std::cout << "  in: " << task.arrivingGuest;
+            std::cout << "\n";
+        }
+        totalTasks += route.tasks.size();
+    }
+    if (totalTasks == 0) {
+        std::cout << "No check-outs or check-ins on " << date << ".\n";
+    }
+}
+
+// Forecast as of the loaded date. The first call makes one pass over the
+// stored reservations, then reads the day files of the history window and
+// the horizon for the stays that are not in memory, without merging them;
+// after that notifyForecast keeps it current.
+const BookingForecaster::Forecast* Hotel::forecast() {
+    int asOfDay = dateToDayNumber(loadedDate);
+    if (asOfDay < 0) return nullptr;
+
+    if (!forecaster || forecaster->day() != asOfDay) {
+        std::vector<BookingForecaster::RoomTypeInfo> types;
+        for (const auto& type : roomTypes) {
+            types.push_back({ type.first, type.second.totalRooms, type.second.pricePerNight });
+        }
+        forecaster.reset(new BookingForecaster(asOfDay, types));
+        forecastFileRows.clear();
+        for (const auto& dayRows : partitionRows) {
+            dayRows.second.forEachLive([this](const Reservation& r) { notifyForecast(r, true); });
+        }
+
+        // Rows on file that memory does not hold: memory has the room that
+        // night, or removed the row and has not written the file yet
+        std::vector<Reservation> removed = removedSincePublish;
+        {
+            std::lock_guard<std::mutex> lock(storeMutex);
+            for (const auto& date : removedRows) {
+                removed.insert(removed.end(), date.second.begin(), date.second.end());
+            }
+        }
+        auto isRemoved = [&removed](const Reservation& r) {
+            return std::any_of(removed.begin(), removed.end(), [&r](const Reservation& x) {
+                return x.guestName == r.guestName && x.roomNumber == r.roomNumber &&
+                       x.stayDate == r.stayDate;
+            });
+        };
+
+        // The history window, with the stays running into it, and the horizon
+        const int firstDay = asOfDay - BookingForecaster::defaultHistoryDays - (stayLookbackDays - 1);
+        const int lastDay = asOfDay + BookingForecaster::horizonDays - 1;
+        DayFile file;
+        for (int day = std::max(firstDay, 0); day <= lastDay; ++day) {
+            const std::string date = dayNumberToDate(day);
+            auto inMemory = reservations.find(date);
+            forEachWorkingDayRow(date, file, [&](const Reservation& r) {
+                if ((inMemory != reservations.end() && inMemory->second.count(r.roomNumber)) ||
+                    isRemoved(r)) {
+                    return;
+                }
+                RoomTypeIt typeIt = roomTypeForRoom(r.roomNumber);
+                if (typeIt == roomTypes.end()) return;
+                // Legacy two-column rows name no type
+                forecaster->addStay(r.roomType.empty() ? typeIt->first : r.roomType,
+                                    day, r.nights, r.bookedDay, r.totalCost);
+                forecastFileRows.insert(forecastRowKey(r));
+            });
+        }
+    }
+    return &forecaster->forecast();
+}
+
+void Hotel::showForecast() {
+    const BookingForecaster::Forecast* result = forecast();
+    if (!result) {
+        std::cout << "Load a valid date (MM-DD-YYYY) to forecast from.\n";
+        return;
+    }
+    auto percent = [](double share) { return static_cast<int>(share * 100.0 + 0.5); };
+
+    const int period = 30;
+    std::cout << "\nForecast as of " << loadedDate << " for the next "
+              << BookingForecaster::horizonDays << " nights (computed in "
+              << static_cast<long>(result->computeMicros) << " us):\n";
+    for (const BookingForecaster::TypeForecast& type : result->types) {
+        std::cout << type.name << " (" << type.totalRooms << " rooms)\n";
+        if (type.hasPace) {
+            std::cout << "  Pace (share of final nights booked):";
+            for (int lead : { 90, 60, 30, 14, 7, 1 }) {
+                std::cout << " " << lead << "d " << percent(type.pace[lead]) << "%";
+            }
+            std::cout << "\n";
+        } else {
+            std::cout << "  No history with booking dates; showing the rooms on the books only.\n";
+        }
+        for (int from = 0; from < BookingForecaster::horizonDays; from += period) {
+            int to = std::min(from + period, BookingForecaster::horizonDays);
+            double booked = 0.0, projected = 0.0, revenue = 0.0;
+            for (int k = from; k < to; ++k) {
+                booked += type.onBooks[k];
+                projected += type.projected[k];
+                revenue += type.revenue[k];
+            }
+            double capacity = std::max(1.0, static_cast<double>(type.totalRooms) * (to - from));
+            std::cout << "  " << dayNumberToDate(result->asOfDay + from) << " - "
+                      << dayNumberToDate(result->asOfDay + to - 1) << ": "
+                      << percent(booked / capacity) << "% booked, "
+                      << percent(projected / capacity) << "% projected, $"
+                      << static_cast<long long>(revenue + 0.5) << "\n";
+        }
+    }
+    std::cout << "Projected revenue, next " << BookingForecaster::horizonDays << " nights: $"
+              << static_cast<long long>(result->totalRevenue + 0.5) << "\n";
+}
+
+// Allow derived classes to build the graph
+void Hotel::addGraphEdge(int roomA, int roomB) {
+    roomGraph[roomA].push_back(roomB);
+    roomGraph[roomB].push_back(roomA);
+}
+
+// MM-DD-YYYY -> days since 01-01-1970 (-1 if the string is not a valid date)
+int Hotel::dateToDayNumber(const string& date) {
+    if (date.size() != 10 || date[2] != '-' || date[5] != '-') return -1;
+    for (int i : { 0, 1, 3, 4, 6, 7, 8, 9 }) {
+        if (!std::isdigit(static_cast<unsigned char>(date[i]))) return -1;
+    }
+    int m = (date[0] - '0') * 10 + (date[1] - '0');
+    int d = (date[3] - '0') * 10 + (date[4] - '0');
+    int y = std::stoi(date.substr(6, 4));
+
+    static const int daysInMonth[] = { 31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31 };
+    bool leap = (y % 4 == 0 && y % 100 != 0) || y % 400 == 0;
+    if (y < 1970 || m < 1 || m > 12 || d < 1) return -1;
+    if (d > daysInMonth[m - 1] + ((m == 2 && leap) ? 1 : 0)) return -1;
+
+    // Civil-from-days inverse (proleptic Gregorian calendar)
+    y -= m <= 2;
+    int era = (y >= 0 ? y : y - 399) / 400;
+    int yoe = y - era * 400;
+    int doy = (153 * (m + (m > 2 ? -3 : 9)) + 2) / 5 + d - 1;
+    int doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+    return era * 146097 + doe - 719468;
+}
+
+// Days since 01-01-1970 -> MM-DD-YYYY
+std::string Hotel::dayNumberToDate(int dayNumber) {
+    int z = dayNumber + 719468;
+    int era = (z >= 0 ? z : z - 146096) / 146097;
+    int doe = z - era * 146097;
+    int yoe = (doe - doe / 1460 + doe / 36524 - doe / 146096) / 365;
+    int y = yoe + era * 400;
+    int doy = doe - (365 * yoe + yoe / 4 - yoe / 100);
+    int mp = (5 * doy + 2) / 153;
+    int d = doy - (153 * mp + 2) / 5 + 1;
+    int m = mp + (mp < 10 ? 3 : -9);
+    y += m <= 2;
+
+    char buffer[16];
+    std::snprintf(buffer, sizeof(buffer), "%02d-%02d-%04d", m % 100, d % 100, y % 10000);
+    return buffer;
+}
+
+// Optional helper: get the real system date (not strictly required)
+std::string Hotel::getCurrentDate() {
+    tm now;
+    std::time_t t2 = std::time(nullptr);
+#ifdef _WIN32
+    localtime_s(&now, &t2);
+#else
+    now = *std::localtime(&t2);
+#endif
+    char buffer[11];
+    std::strftime(buffer, sizeof(buffer), "%m-%d-%Y", &now);
+    return buffer;
+}
+
+// Requirement 18: Derived class that initializes room types and pricing
+// (catalog in hiltonRooms, hotel.h)
+HiltonHotel::HiltonHotel(int totalRooms) : FixedLayoutHotel("Hilton", totalRooms) {}
@@ -0,0 +1,617 @@
+#ifndef HOTEL_H
+#define HOTEL_H
+
+#include <string>
+#include <map>
+#include <vector>
+#include <list>          // List
+#include <stack>         // Stack (undo)
+#include <unordered_map> // Hash table
+#include <unordered_set>
+#include <set>
+#include <chrono>
+#include <mutex>
+#include <condition_variable>
+#include <thread>
+#include <memory>
+#include <functional>
+#include <algorithm>
+
+#include "forecast.h"
+#include "housekeeping.h"
+#include "memory_accounting.h"
+#include "room_assignment.h"
+#include "room_catalog.h"
+#include "snapshot.h"
+
+class HistoryStore;
+
+// Requirement 1: Use classes, inheritance, and encapsulation
+class Hotel {
+protected:
+    // Requirement 2: Use a struct to group related room data
+    struct RoomType {
+        std::string description;
+        int totalRooms;
+        int availableRooms;
+        double pricePerNight;
+        std::string roomRange;
+        std::vector<int> availableRoomNumbers;  // Requirement 3: Use STL vector
+        Counted<MemoryArea::RoomGuests>::map<int, std::string> guests;   // Requirement 4: Use STL map
+        std::vector<int> allRoomNumbers;        // used to reset availability per day
+    };
+
+    // Explicit tree node (Requirement: Tree)
+    struct TreeNode {
+        int roomNumber;
+        TreeNode* left;
+        TreeNode* right;
+
+        // Nodes are charged to MemoryArea::OccupiedTree
+        static void* operator new(std::size_t) {
+            return CountingAllocator<TreeNode, MemoryArea::OccupiedTree>().allocate(1);
+        }
+        static void operator delete(void* p) noexcept {
+            CountingAllocator<TreeNode, MemoryArea::OccupiedTree>().deallocate(static_cast<TreeNode*>(p), 1);
+        }
+    };
+
+    // For undo stack (Requirement: Stack)
+    struct Action {
+        std::string guestName;
+        std::string date;       // stay date (reservation date)
+        int roomNumber;
+        int nights;
+        double pricePerNight;
+        double totalCost;
+    };
+
+public:
+    // Detailed reservation record for saving
+    struct Reservation {
+        std::string guestName;
+        int roomNumber;
+        std::string roomType;
+        std::string stayDate;   // reservation date
+        int nights;
+        int checkInHour;
+        double pricePerNight;
+        double totalCost;
+        int bookedDay = -1;     // day the booking was made (see dateToDayNumber), -1 if not recorded
+    };
+
+    // Immutable view of the booking state as of one completed operation.
+    // Rows and session lists are stored in shared chunks (snapshot.h) and
+    // dates are grouped by month, so a booking copies only the chunk, the
+    // month and the month list it changes.
+    struct Snapshot {
+        struct TypeAvailability {
+            std::string name;
+            int totalRooms;
+            int availableRooms;
+            double pricePerNight;
+            std::string roomRange;
+        };
+
+        struct SessionBooking {
+            std::string guestName;
+            int roomNumber;
+        };
+
+        typedef CowChunks<Reservation, 64, Counted<MemoryArea::SnapshotChunks>::allocator<Reservation>> RowChunks;
+        typedef CowChunks<SessionBooking, 64, Counted<MemoryArea::SnapshotChunks>::allocator<SessionBooking>> SessionChunks;
+        typedef CowChunks<std::string, 64, Counted<MemoryArea::SnapshotChunks>::allocator<std::string>> NameChunks;
+
+        typedef RowChunks::Frozen DayRows;
+        typedef std::vector<std::pair<std::string, std::shared_ptr<const DayRows>>> MonthDays;   // by date
+        typedef std::vector<std::pair<std::string, std::shared_ptr<const MonthDays>>> DayIndex;  // by month
+
+        unsigned long long version = 0;
+        std::string loadedDate;
+        double totalRevenue = 0.0;
+        std::vector<TypeAvailability> roomTypes;                 // menu order
+        std::shared_ptr<const DayIndex> days;                    // rows by stay date
+        SessionChunks::Frozen sessionBookings;                   // people / roomsnums
+        NameChunks::Frozen guestHistory;
+
+        // "YYYY-MM" for an MM-DD-YYYY date (anything else is its own month)
+        static std::string monthOf(const std::string& date) {
+            if (date.size() != 10) return date;
+            return date.substr(6, 4) + "-" + date.substr(0, 2);
+        }
+
+        // Rows stored for a date, in booking order (nullptr if none)
+        const DayRows* rowsFor(const std::string& date) const {
+            const MonthDays* month = find(*days, monthOf(date));
+            if (!month) return nullptr;
+            return find(*month, date);
+        }
+
+    private:
+        template <class Entries>
+        static const typename Entries::value_type::second_type::element_type*
+        find(const Entries& entries, const std::string& key) {
+            auto it = std::lower_bound(entries.begin(), entries.end(), key,
+                                       [](const typename Entries::value_type& e, const std::string& k) {
+                                           return e.first < k;
+                                       });
+            return it == entries.end() || it->first != key ? nullptr : it->second.get();
+        }
+    };
+
+protected:
+    std::string name;
+    int totalRooms;
+    double totalRevenue;
+
+    // Track all reservations made/loaded in this session
+    Counted<MemoryArea::People>::vector<std::string> people;    // guest names
+    Counted<MemoryArea::RoomNumbers>::vector<int> roomsnums;    // room numbers
+
+    // All reservations (can be for multiple dates), grouped by stay date.
+    // The chunks are shared with published snapshots, so this is the only
+    // copy of each row.
+    std::map<std::string, Snapshot::RowChunks> partitionRows;
+
+    // reservations[date][roomNumber] = guestName
+    typedef Counted<MemoryArea::Reservations>::map<int, std::string> RoomGuests;
+    Counted<MemoryArea::Reservations>::map<std::string, RoomGuests> reservations;
+
+    // Hash table for guest lookups
+    Counted<MemoryArea::GuestToRooms>::unordered_map<
+        std::string, Counted<MemoryArea::GuestToRooms>::vector<int>> guestToRooms;
+
+    // List for guest history
+    Counted<MemoryArea::GuestHistory>::list<std::string> guestHistory;
+
+    // Tree for occupied rooms
+    TreeNode* occupiedRoomsRoot;
+
+    // Graph (adjacency list of room connections)
+    std::map<int, std::vector<int>> roomGraph;
+
+    // Booked nights per room across all dates (for multi-night assignment)
+    RoomCalendar calendar;
+
+    // Pick rooms by best fit against the calendar (false: first free room)
+    bool bestFitAssignment;
+
+    // Stack for undo operations
+    std::stack<Action, Counted<MemoryArea::BookingHistory>::deque<Action>> bookingHistory;
+
+    // Stay date of the file last loaded with loadFromFile ("today")
+    std::string loadedDate;
+
+    // ---- Incremental saving ----
+    // Dates whose reservations changed since they were last written. A
+    // date is marked dirty when the snapshot holding the change is
+    // published, so the flusher writes rows from snapshot() and never reads
+    // the booking thread's partitions. storeMutex guards dirtyDates.
+    std::set<std::string> changedDates;     // since the last publish (booking thread)
+    std::set<std::string> dirtyDates;
+
+    // A flush merges with the rows already in the file, so it never drops
+    // a stay that is not in memory. Rows undone or moved since their date
+    // was written are kept here so the merge does not bring them back;
+    // they are handed over at publish time, like changedDates.
+    std::vector<Reservation> removedSincePublish;                   // booking thread
+    std::map<std::string, std::vector<Reservation>> removedRows;     // storeMutex
+    std::mutex storeMutex;
+    std::mutex flushMutex;              // one flush writes files at a time
+    std::condition_variable flushCv;    // wakes the flusher when a date gets dirty
+    std::thread flusherThread;
+    bool stopFlusher;
+
+    // ---- Published snapshots ----
+    // The booking thread keeps rows in copy-on-write partitions
+    // (partitionRows) and publishes a new Snapshot after each operation;
+    // readers load the current one atomically and never take storeMutex.
+    std::shared_ptr<const Snapshot> published;
+    unsigned long long snapshotVersion;
+    std::map<std::string, std::map<std::string, std::shared_ptr<const Snapshot::DayRows>>> frozenDays;   // month -> date
+    std::map<std::string, std::shared_ptr<const Snapshot::MonthDays>> frozenMonths;
+    std::shared_ptr<const Snapshot::DayIndex> publishedDays;
+    std::set<std::string> stalePartitions;              // dates changed since publishing
+    Snapshot::SessionChunks sessionLog;                 // mirrors people / roomsnums
+    Snapshot::NameChunks guestLog;                      // mirrors guestHistory
+
+    // Publish the current state (booking thread only)
+    void publishSnapshot();
+
+    // Turnover plan kept up to date as bookings change (null until requested)
+    std::unique_ptr<TurnoverScheduler> turnover;
+
+    // Feed one reservation change to the turnover plan, if there is one
+    void notifyTurnover(const Reservation& r, bool added);
+
+    // Booking-pace forecast as of the loaded date (null until requested)
+    std::unique_ptr<BookingForecaster> forecaster;
+
+    // Feed one reservation change to the forecast, if there is one
+    void notifyForecast(const Reservation& r, bool added);
+
+    // Rows the forecast read from day files without bringing them into
+    // memory ("date\troom\tguest"). Such a row is already counted when it
+    // is merged into memory later.
+    std::unordered_set<std::string> forecastFileRows;
+    static std::string forecastRowKey(const Reservation& r);
+
+    // Day files read on demand for dates and guests not in memory (null
+    // until attachHistory)
+    std::unique_ptr<HistoryStore> history;
+    bool historyIsWorkingDirectory = false;    // pages the files the hotel writes
+
+    // A date's file was written or removed: drop what history read of it
+    void invalidateHistory(const std::string& date);
+
+    // Write one date's rows to <date>.txt (returns false on I/O failure)
+    static bool writeDayFile(const std::string& date, const std::vector<Reservation>& rows);
+
+    // Memory's rows for a date plus the file's rows that are neither in
+    // memory (same room and guest) nor removed. File rows on a room memory
+    // gives to another guest go to clashes; the date must not be written.
+    static std::vector<Reservation> mergeWithFile(const std::string& date,
+                                                  std::vector<Reservation> rows,
+                                                  const std::vector<Reservation>& removed,
+                                                  std::vector<Reservation>& clashes);
+
+    // Write dates from the current snapshot, merged with their files
+    // (flushMutex held). Dates that fail go back to dirtyDates.
+    size_t writeDates(const std::set<std::string>& dates,
+                      std::map<std::string, std::vector<Reservation>>& removed);
+
+    // ---- Day files merged into memory ----
+    // Day number -> every stay in that date's file that ends after this
+    // day is in memory (since the last load). A value <= the date's own
+    // day means the whole file; absent means none of it.
+    std::unordered_map<int, int> mergedEndsAfter;
+
+    // Bring the stays in the files for [firstDay, lastDay] that end after
+    // endsAfter into memory, as stored rows rather than session bookings.
+    // Returns true if any row was added (the caller publishes).
+    bool mergeStaysFromDisk(int firstDay, int lastDay, int endsAfter);
+
+    // One row read from a file; false if its room is unknown or taken
+    bool adoptStoredRow(const Reservation& r);
+
+    // Helper: split a string by a delimiter (used for file parsing)
+    static std::vector<std::string> split(const std::string& s, char delim);
+
+    // Day-file fields holding a comma or a quote are written quoted ("a, b",
+    // with "" for a quote); splitRow reads them back and keeps empty fields
+    static std::string quoteField(const std::string& s);
+    static std::vector<std::string> splitRow(const std::string& line);
+
+    // HistoryStore pages day files in with parseDayFile
+    friend class HistoryStore;
+
+    // Parsed contents of one <date>.txt file
+    struct DayFile {
+        std::string date;
+        double totalRevenue = 0.0;
+        std::vector<Reservation> rows;
+    };
+
+    enum class ParseStatus { Ok, Missing, Empty };
+
+    // Read a day file into a DayFile without touching hotel state
+    static ParseStatus parseDayFile(const std::string& path,
+                                    const std::string& date,
+                                    DayFile& out);
+
+    // Visit the rows of <date>.txt in the working directory: from the
+    // attached history's pages when it holds this directory, otherwise
+    // parsed into buffer. False if the date has no readable file.
+    bool forEachWorkingDayRow(const std::string& date, DayFile& buffer,
+                              const std::function<void(const Reservation&)>& fn);
+
+    // ---- Tree helper functions ----
+    TreeNode* insertRoomInTree(TreeNode* node, int roomNumber);
+    TreeNode* findMinNode(TreeNode* node);
+    TreeNode* removeRoomFromTree(TreeNode* node, int roomNumber);
+    void inorderPrint(TreeNode* node);
+    void clearTree(TreeNode* node);
+
+    // Requirement 6: Ability to reset hotel state for a "new day"
+    void resetStateForNewDate();
+
+    // ---- Room catalog lookups ----
+    // The runtime-configured defaults search roomTypes / roomGraph;
+    // FixedLayoutHotel replaces them with compile-time tables.
+    typedef std::map<std::string, RoomType>::iterator RoomTypeIt;
+
+    // Room type that owns a room (roomTypes.end() if none)
+    virtual RoomTypeIt roomTypeForRoom(int roomNumber);
+
+    // Room type for a 1-based menu option (roomTypes.end() if out of range)
+    virtual RoomTypeIt roomTypeByOption(int option);
+
+    // Rooms directly connected to a room; false if the room is not in the graph
+    virtual bool roomNeighbors(int roomNumber, const int*& first, size_t& count);
+
+    // Does a stay starting on startDay overlap the loaded date? Only those
+    // stays take rooms out of today's availableRoomNumbers. Unknown dates
+    // count as today, as they always did.
+    bool coversLoadedDay(int startDay, int nights) const;
+
+    // Book a room on the calendar and, if the stay covers the loaded day,
+    // take it out of today's rooms. False if it is not free.
+    bool holdRoom(RoomTypeIt typeIt, int roomNumber, int startDay, int nights,
+                  const std::string& guestName);
+
+    // Core booking logic (does NOT touch totalRevenue directly)
+    bool bookRoom(const std::string& guestName,
+                  const std::string& date,
+                  int roomNumber,
+                  int nights = 1);
+
+    // A stored row (its stay date and position in partitionRows) and the
+    // room it moves to
+    struct RoomMove {
+        std::string date;
+        size_t row;
+        int newRoom;
+    };
+
+    // Reassign stored reservations to other rooms in every index
+    void applyRoomMoves(const std::vector<RoomMove>& moves);
+
+public:
+    // Requirement 8: Maintain multiple room types in a map
+    std::map<std::string, RoomType> roomTypes;
+
+    Hotel(std::string hotelName, int totalRooms);
+    virtual ~Hotel();
+
+    // Latest published snapshot. Safe to call from any thread, concurrently
+    // with bookings; the reports below all read from one snapshot.
+    std::shared_ptr<const Snapshot> snapshot() const;
+
+    // Requirement 9: Show menu-driven interface
+    void showOptions();
+
+    // Requirement 10: Display available room types and counts
+    void showAvailableRooms(const std::string& todayDate);
+
+    // Requirement 11: Prompt user for reservation details (date, nights, time)
+    void promptForReservationDetails(std::string& startDate,
+                                     std::string& endDate,
+                                     int& startTime,
+                                     int& durationDays);
+
+    // Requirement 12: Reserve a room of given type (option) for a guest.
+    // Returns the room assigned, or -1 if nothing was booked; bookedCost,
+    // if given, receives the booking's total cost.
+    int reserveRoom(int option,
+                    const std::string& guestName,
+                    const std::string& startDate,
+                    const std::string& endDate,
+                    int startTime,
+                    int durationDays,
+                    double* bookedCost = nullptr);
+
+    // Requirement 13: Show total revenue and list of guests for current date
+    void getTotal();
+
+    // Requirement 14: Display room availability by type
+    void displayRoomAvailability();
+
+    // Requirement 15: Save reservations for a specific reservation date to <date>.txt
+    void saveToFile(const std::string& date);
+
+    // Requirement 16: Load reservations and revenue from file for a given date
+    void loadFromFile(const std::string& date);
+
+    // Loads and bookings first merge the day files of the dates they touch
+    // and of the days before, back far enough to see stays of up to this
+    // many nights running into them
+    static constexpr int stayLookbackDays = 30;
+
+    // Write only the dates changed since their last save; returns files written
+    size_t flushDirty();
+
+    // Flush dirty dates on a background thread, shortly after they change
+    void startBackgroundFlusher(std::chrono::milliseconds delay = std::chrono::milliseconds(200));
+
+    // Stop the background thread and flush whatever is still pending
+    void stopBackgroundFlusher();
+
+    // Outcome of a bulk import
+    struct ImportReport {
+        size_t filesFound = 0;
+        size_t rowsParsed = 0;
+        size_t imported = 0;
+        std::vector<std::string> conflicts;   // double bookings, unknown rooms, ...
+        double parseMillis = 0.0;
+        double mergeMillis = 0.0;
+    };
+
+    // Bulk import every <MM-DD-YYYY>.txt file in a directory, parsing on
+    // threadCount threads (0 = one per hardware thread). Unlike loadFromFile
+    // this adds to the current state instead of resetting it.
+    ImportReport importDirectory(const std::string& directory, unsigned threadCount = 0);
+
+    // Outcome of a re-optimization pass
+    struct ReoptimizeReport {
+        size_t staysConsidered = 0;
+        size_t staysMoved = 0;
+        long capacityBefore = 0;   // room-nights sellable to long stays
+        long capacityAfter = 0;
+    };
+
+    // Nightly batch: repack stays arriving after asOfDate (not yet checked
+    // in, and not holding a room today) so that free nights form long gaps.
+    // Changes are kept only if long-stay capacity goes up.
+    ReoptimizeReport reoptimizeAssignments(const std::string& asOfDate);
+
+    // Choose best-fit (default) or first-free room assignment
+    void setBestFitAssignment(bool enabled) { bestFitAssignment = enabled; }
+
+    // Heap use of one internal structure
+    struct MemoryUsage {
+        std::string structure;
+        size_t elements = 0;
+        long long bytes = 0;         // container memory, from its allocator
+        long long peakBytes = 0;
+        long long stringBytes = 0;   // heap buffers of strings it holds
+    };
+
+    struct MemoryReport {
+        std::vector<MemoryUsage> structures;   // in MemoryArea order
+        long long totalBytes = 0;              // container + string bytes
+        long long peakContainerBytes = 0;      // peak of all containers together
+    };
+
+    // Measure every tracked structure (walks the containers for element
+    // counts and string buffers; booking thread only)
+    MemoryReport memoryReport() const;
+
+    // Print memoryReport() as a table
+    void showMemoryUsage() const;
+
+    // Outcome of a columnar export
+    struct ExportReport {
+        bool ok = false;
+        std::string error;
+        size_t filesRead = 0;               // day files (exportDirectoryColumnar)
+        unsigned long long rows = 0;
+        size_t rowGroups = 0;
+        unsigned long long bytes = 0;       // size of the written file
+        double millis = 0.0;
+    };
+
+    // Stream every stored reservation, in date order, from the current
+    // snapshot into a columnar file (see columnar.h). Holds one row group
+    // in memory at a time.
+    ExportReport exportColumnar(const std::string& path, size_t rowGroupRows = 65536) const;
+
+    // Convert every <MM-DD-YYYY>.txt in a directory, one file at a time in
+    // date order, without loading them into a hotel
+    static ExportReport exportDirectoryColumnar(const std::string& directory,
+                                                const std::string& path,
+                                                size_t rowGroupRows = 65536);
+
+    // Print the rows and revenue of a columnar file for a date range
+    static void showColumnarScan(const std::string& path,
+                                 const std::string& fromDate,
+                                 const std::string& toDate);
+
+    // Occupancy and revenue for the next 90 nights after the loaded date,
+    // per room type, from the stored reservations' booking pace. Built on
+    // the first call; later bookings and undos update it incrementally.
+    // Returns nullptr if no valid date is loaded.
+    const BookingForecaster::Forecast* forecast();
+
+    // Print forecast() by week, with each type's pace curve
+    void showForecast();
+
+    // Serve dates and guests that are not in memory from the day files in
+    // a directory. Nothing is read here: a date's file is paged in the first
+    // time it is asked for and kept under an LRU byte budget (see history.h).
+    // Call before startBackgroundFlusher.
+    void attachHistory(const std::string& directory, size_t budgetBytes = 64u << 20);
+
+    // The attached store (nullptr if none)
+    HistoryStore* historyStore() const { return history.get(); }
+
+    // Requirement 17: Show reservations for a specific date (from the
+    // attached history if the date is not in memory)
+    void showReservationsForDate(const std::string& date);
+
+    // Hash table lookup, plus the guest's stays in the attached history
+    void findGuestReservations(const std::string& guestName);
+
+    // Undo last booking (stack); false if there was nothing to undo
+    bool undoLastBooking();
+
+    // Show occupied rooms via tree traversal
+    void displayOccupiedRoomsInOrder();
+
+    // Graph traversal (BFS using roomGraph and std::queue)
+    void bfsFromRoom(int startRoom);
+
+    // List guest history
+    void showGuestHistory();
+
+    // Housekeeping: rooms to turn over on a date, split by floor among
+    // housekeepers and ordered by check-in hour, then by walking distance
+    void showTurnoverPlan(const std::string& date, int housekeepers);
+
+    // Allow derived classes to build the graph
+    void addGraphEdge(int roomA, int roomB);
+
+    // Date helpers: MM-DD-YYYY <-> days since 01-01-1970 (-1 if invalid or before 1970)
+    static int dateToDayNumber(const std::string& date);
+    static std::string dayNumberToDate(int dayNumber);
+
+    // Optional helper: get the real system date (not strictly required)
+    std::string getCurrentDate();
+};
+
+// Property whose room catalog is fixed at compile time (see room_catalog.h).
+// Room -> type, menu option -> type and adjacency come from static tables.
+// roomTypes is still filled from the table at construction, one entry per
+// type, because it holds the per-day availability and guests that every
+// report and booking path reads.
+template <const auto& Ranges, const auto& Links = noRoomLinks>
+class FixedLayoutHotel : public Hotel {
+public:
+    typedef FixedRoomCatalog<Ranges, Links> Catalog;
+
+    FixedLayoutHotel(std::string hotelName, int totalRooms = Catalog::roomCount)
+        : Hotel(hotelName, totalRooms) {
+        for (std::size_t t = 0; t < Catalog::typeCount; ++t) {
+            const RoomRangeSpec& spec = Catalog::type(t);
+            int count = spec.lastRoom - spec.firstRoom + 1;
+
+            RoomTypeIt it = roomTypes.emplace(spec.typeName, RoomType{
+                spec.typeName, count, count, spec.pricePerNight, spec.rangeLabel, {}, {}, {} }).first;
+            it->second.allRoomNumbers.reserve(count);
+            for (int room = spec.firstRoom; room <= spec.lastRoom; ++room) {
+                it->second.allRoomNumbers.push_back(room);
+            }
+            it->second.availableRoomNumbers = it->second.allRoomNumbers;
+            typeSlots[t] = it;
+        }
+        publishSnapshot();
+    }
+
+protected:
+    RoomTypeIt roomTypeForRoom(int roomNumber) override {
+        int index = Catalog::typeIndexOf(roomNumber);
+        return index < 0 ? roomTypes.end() : typeSlots[index];
+    }
+
+    RoomTypeIt roomTypeByOption(int option) override {
+        if (option < 1 || option > static_cast<int>(Catalog::typeCount)) return roomTypes.end();
+        return typeSlots[option - 1];
+    }
+
+    bool roomNeighbors(int roomNumber, const int*& first, size_t& count) override {
+        if (Catalog::typeIndexOf(roomNumber) < 0) return false;
+        const typename Catalog::Neighbors& n = Catalog::neighborsOf(roomNumber);
+        first = n.rooms;
+        count = static_cast<size_t>(n.count);
+        return true;
+    }
+
+private:
+    // roomTypes entries in menu order (map iterators stay valid)
+    RoomTypeIt typeSlots[Catalog::typeCount];
+};
+
+// Requirement 18: Derived class that initializes room types and pricing.
+// Hilton's layout never changes, so its catalog is compiled in.
+inline constexpr RoomRangeSpec hiltonRooms[] = {
+    { "Deluxe Suite",              236, 250,  350.0, "236 thru 250" },
+    { "Penthouse",                 301, 302, 1135.0, "301 and 302" },
+    { "Standard Room, Scenic",     201, 235,  145.0, "201 thru 235" },
+    { "Standard Rooms, Courtyard", 101, 170,  125.0, "101 thru 170" },
+};
+
+class HiltonHotel : public FixedLayoutHotel<hiltonRooms> {
+public:
+    HiltonHotel(int totalRooms);
+};
+
+#endif // HOTEL_H
@@ -0,0 +1,215 @@
+#include "housekeeping.h"
+
+#include <algorithm>
+#include <climits>
+#include <cstdlib>
+#include <queue>
+#include <unordered_map>
+
+using namespace std;
+
+TurnoverScheduler::TurnoverScheduler(int planDay, int housekeepers, NeighborFn neighbors)
+    : planDay(planDay),
+      housekeeperCount(housekeepers < 1 ? 1 : housekeepers),
+      neighbors(neighbors),
+      floorsChanged(true),
+      replannedFloors(0) {}
+
+bool TurnoverScheduler::taskFor(int roomNumber, const RoomSlot& slot, Task& task) {
+    if (slot.departing.empty() && slot.arriving.empty()) {
+        return false;
+    }
+
+    task.roomNumber = roomNumber;
+    task.departingGuest = slot.departing.empty() ? "" : slot.departing.back();
+    task.arrivingGuest.clear();
+    task.readyByHour = 24;
+
+    // Earliest arrival sets the deadline
+    for (const auto& arrival : slot.arriving) {
+        if (arrival.first < task.readyByHour) {
+            task.readyByHour = arrival.first;
+            task.arrivingGuest = arrival.second;
+        }
+    }
+
+    if (slot.arriving.empty()) task.kind = Departure;
+    else if (slot.departing.empty()) task.kind = Arrival;
+    else task.kind = Turnover;
+    return true;
+}
+
+void TurnoverScheduler::dequeue(int roomNumber, const RoomSlot& slot) {
+    Task task;
+    if (!taskFor(roomNumber, slot, task)) return;
+
+    int floor = floorOf(roomNumber);
+    auto queueIt = floorQueues.find(floor);
+    if (queueIt == floorQueues.end()) return;
+
+    queueIt->second.erase({ { task.readyByHour, task.kind }, roomNumber });
+    if (queueIt->second.empty()) {
+        floorQueues.erase(queueIt);
+        floorsChanged = true;
+    }
+    dirtyFloors.insert(floor);
+}
+
+void TurnoverScheduler::enqueue(int roomNumber, const RoomSlot& slot) {
+    Task task;
+    if (!taskFor(roomNumber, slot, task)) return;
+
+    int floor = floorOf(roomNumber);
+    std::set<QueueKey>& queue = floorQueues[floor];
+    if (queue.empty()) floorsChanged = true;
+    queue.insert({ { task.readyByHour, task.kind }, roomNumber });
+    dirtyFloors.insert(floor);
+}
+
+void TurnoverScheduler::addStay(const std::string& guest, int roomNumber, int arrivalDay,
+                                int nights, int checkInHour) {
+    bool arrives = arrivalDay == planDay;
+    bool departs = arrivalDay + nights == planDay;
+    if (!arrives && !departs) return;
+
+    RoomSlot& slot = rooms[roomNumber];
+    dequeue(roomNumber, slot);
+    if (departs) slot.departing.push_back(guest);
+    if (arrives) slot.arriving.push_back({ checkInHour, guest });
+    enqueue(roomNumber, slot);
+}
+
+void TurnoverScheduler::removeStay(const std::string& guest, int roomNumber, int arrivalDay,
+                                   int nights, int checkInHour) {
+    bool arrives = arrivalDay == planDay;
+    bool departs = arrivalDay + nights == planDay;
+    if (!arrives && !departs) return;
+
+    auto slotIt = rooms.find(roomNumber);
+    if (slotIt == rooms.end()) return;
+    RoomSlot& slot = slotIt->second;
+
+    dequeue(roomNumber, slot);
+    if (departs) {
+        auto it = std::find(slot.departing.begin(), slot.departing.end(), guest);
+        if (it != slot.departing.end()) slot.departing.erase(it);
+    }
+    if (arrives) {
+        auto it = std::find(slot.arriving.begin(), slot.arriving.end(),
+                            std::make_pair(checkInHour, guest));
+        if (it != slot.arriving.end()) slot.arriving.erase(it);
+    }
+    enqueue(roomNumber, slot);
+
+    if (slot.departing.empty() && slot.arriving.empty()) {
+        rooms.erase(slotIt);
+    }
+}
+
+// Order one floor's queue: deadline groups in priority order, and inside a
+// group walk to the nearest remaining room (BFS distance in the room graph)
+void TurnoverScheduler::routeFloor(int floor) {
+    auto queueIt = floorQueues.find(floor);
+    if (queueIt == floorQueues.end()) {
+        floorRoutes.erase(floor);
+        return;
+    }
+
+    std::vector<Task>& route = floorRoutes[floor];
+    route.clear();
+
+    int position = -1;   // room the housekeeper is standing at
+    const std::set<QueueKey>& queue = queueIt->second;
+    for (auto groupStart = queue.begin(); groupStart != queue.end();) {
+        auto groupEnd = groupStart;
+        std::vector<int> group;
+        while (groupEnd != queue.end() && groupEnd->first == groupStart->first) {
+            group.push_back(groupEnd->second);
+            ++groupEnd;
+        }
+
+        while (!group.empty()) {
+            size_t best = 0;
+            if (position >= 0) {
+                // BFS distances from the current room
+                std::unordered_map<int, int> distance;
+                std::queue<int> pending;
+                distance[position] = 0;
+                pending.push(position);
+                while (!pending.empty()) {
+                    int room = pending.front();
+                    pending.pop();
+                    const int* next = nullptr;
+                    size_t count = 0;
+                    if (!neighbors(room, next, count)) continue;
+                    for (size_t i = 0; i < count; ++i) {
+                        if (distance.emplace(next[i], distance[room] + 1).second) {
+                            pending.push(next[i]);
+                        }
+                    }
+                }
+
+                long bestDistance = LONG_MAX;
+                for (size_t i = 0; i < group.size(); ++i) {
+                    auto found = distance.find(group[i]);
+                    // Unconnected rooms fall back to room-number distance
+                    long d = found != distance.end()
+                                 ? found->second
+                                 : INT_MAX + static_cast<long>(std::abs(group[i] - position));
+                    if (d < bestDistance || (d == bestDistance && group[i] < group[best])) {
+                        bestDistance = d;
+                        best = i;
+                    }
+                }
+            }
+
+            Task task;
+            taskFor(group[best], rooms[group[best]], task);
+            route.push_back(task);
+            position = group[best];
+            group.erase(group.begin() + static_cast<long>(best));
+        }
+        groupStart = groupEnd;
+    }
+}
+
+const std::vector<TurnoverScheduler::HousekeeperRoute>& TurnoverScheduler::plan() {
+    replannedFloors = dirtyFloors.size();
+
+    // Floors are dealt out to housekeepers in ascending order
+    std::map<int, int> owner;   // floor -> housekeeper index
+    int index = 0;
+    for (const auto& entry : floorQueues) {
+        owner[entry.first] = index++ % housekeeperCount;
+    }
+
+    std::set<int> affected;     // housekeepers whose route changed
+    for (int floor : dirtyFloors) {
+        routeFloor(floor);
+        auto it = owner.find(floor);
+        if (it != owner.end()) affected.insert(it->second);
+    }
+    dirtyFloors.clear();
+
+    if (floorsChanged || routes.size() != static_cast<size_t>(housekeeperCount)) {
+        routes.assign(housekeeperCount, HousekeeperRoute());
+        for (int h = 0; h < housekeeperCount; ++h) {
+            routes[h].housekeeper = h + 1;
+            affected.insert(h);
+        }
+        floorsChanged = false;
+    }
+
+    for (int h : affected) {
+        HousekeeperRoute& route = routes[h];
+        route.floors.clear();
+        route.tasks.clear();
+        for (const auto& entry : owner) {
+            if (entry.second != h) continue;
+            route.floors.push_back(entry.first);
+            const std::vector<Task>& floorTasks = floorRoutes[entry.first];
+            route.tasks.insert(route.tasks.end(), floorTasks.begin(), floorTasks.end());
+        }
+    }
+    return routes;
+}
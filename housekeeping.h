@@ -0,0 +1,95 @@
+#ifndef HOUSEKEEPING_H
+#define HOUSEKEEPING_H
+
+#include <cstddef>
+#include <functional>
+#include <map>
+#include <set>
+#include <string>
+#include <utility>
+#include <vector>
+
+// Daily room-turnover plan for housekeeping.
+//
+// The scheduler covers one day. It is fed stays (addStay / removeStay) and
+// keeps, per floor, an ordered work queue of rooms that check out and/or
+// check in that day, keyed by the hour the room must be ready. A booking
+// change only touches its room's queue entry and marks that floor for
+// re-routing; plan() re-routes just the dirty floors.
+class TurnoverScheduler {
+public:
+    enum TaskKind {
+        Turnover,    // guest checks out and a new guest checks in
+        Arrival,     // room was empty overnight; prepare for check-in
+        Departure    // guest checks out, nobody checks in today
+    };
+
+    struct Task {
+        int roomNumber;
+        TaskKind kind;
+        int readyByHour;                  // check-in hour, 24 if no arrival
+        std::string departingGuest;
+        std::string arrivingGuest;
+    };
+
+    struct HousekeeperRoute {
+        int housekeeper;                  // 1-based
+        std::vector<int> floors;
+        std::vector<Task> tasks;          // in working order
+    };
+
+    // Graph access: neighbours of a room, false if the room is unknown
+    typedef std::function<bool(int, const int*&, size_t&)> NeighborFn;
+
+    TurnoverScheduler(int planDay, int housekeepers, NeighborFn neighbors);
+
+    int day() const { return planDay; }
+    int housekeepers() const { return housekeeperCount; }
+
+    // A stay arriving on arrivalDay for `nights` nights. Stays that neither
+    // arrive nor depart on the planned day are ignored.
+    void addStay(const std::string& guest, int roomNumber, int arrivalDay,
+                 int nights, int checkInHour);
+    void removeStay(const std::string& guest, int roomNumber, int arrivalDay,
+                    int nights, int checkInHour);
+
+    // Current plan; only floors touched since the last call are re-routed
+    const std::vector<HousekeeperRoute>& plan();
+
+    // Floors re-routed by the last plan() call (for reporting)
+    size_t lastReplannedFloors() const { return replannedFloors; }
+
+private:
+    // What happens in one room on the planned day
+    struct RoomSlot {
+        std::vector<std::string> departing;
+        std::vector<std::pair<int, std::string>> arriving;   // (hour, guest)
+    };
+
+    // Work-queue key: earliest deadline first, turnovers before plain
+    // arrivals at the same hour, departures last
+    typedef std::pair<std::pair<int, int>, int> QueueKey;    // ((hour, kind), room)
+
+    static int floorOf(int roomNumber) { return roomNumber / 100; }
+    static bool taskFor(int roomNumber, const RoomSlot& slot, Task& task);
+
+    // Take a room's task out of / back into its floor's work queue
+    void dequeue(int roomNumber, const RoomSlot& slot);
+    void enqueue(int roomNumber, const RoomSlot& slot);
+    void routeFloor(int floor);
+
+    int planDay;
+    int housekeeperCount;
+    NeighborFn neighbors;
+
+    std::map<int, RoomSlot> rooms;
+    std::map<int, std::set<QueueKey>> floorQueues;
+    std::map<int, std::vector<Task>> floorRoutes;
+    std::set<int> dirtyFloors;
+    bool floorsChanged;
+
+    std::vector<HousekeeperRoute> routes;
+    size_t replannedFloors;
+};
+
+#endif // HOUSEKEEPING_H
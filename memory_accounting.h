@@ -0,0 +1,148 @@
+#ifndef MEMORY_ACCOUNTING_H
+#define MEMORY_ACCOUNTING_H
+
+#include <atomic>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <list>
+#include <map>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+// Heap accounting per internal structure.
+//
+// Containers that should be measured use CountingAllocator (usually through
+// the Counted<Area> aliases below). Every allocation and deallocation is
+// added to its area's counter, so the numbers are exact for the container's
+// own memory (nodes, arrays, buckets). Heap buffers of std::string elements
+// go through std::allocator and are measured separately by walking.
+//
+// Counters are process-wide: every Hotel in the process adds to them.
+enum class MemoryArea {
+    People,               // Hotel::people
+    RoomNumbers,          // Hotel::roomsnums
+    Reservations,         // Hotel::reservations
+    GuestToRooms,         // Hotel::guestToRooms
+    GuestHistory,         // Hotel::guestHistory
+    OccupiedTree,         // Hotel::occupiedRoomsRoot nodes
+    BookingHistory,       // Hotel::bookingHistory
+    RoomGuests,           // RoomType::guests
+    Calendar,             // Hotel::calendar
+    SnapshotChunks,       // stored rows and lists, shared with snapshots
+    HistoryCache,         // HistoryStore pages and guest indexes
+    Count
+};
+
+struct MemoryCounter {
+    std::atomic<long long> bytes{ 0 };
+    std::atomic<long long> peakBytes{ 0 };
+    std::atomic<long long> blocks{ 0 };      // live allocations
+
+    void add(std::size_t size) {
+        long long now = bytes.fetch_add(static_cast<long long>(size), std::memory_order_relaxed) +
+                        static_cast<long long>(size);
+        blocks.fetch_add(1, std::memory_order_relaxed);
+        long long peak = peakBytes.load(std::memory_order_relaxed);
+        while (now > peak &&
+               !peakBytes.compare_exchange_weak(peak, now, std::memory_order_relaxed)) {
+        }
+    }
+
+    void remove(std::size_t size) {
+        bytes.fetch_sub(static_cast<long long>(size), std::memory_order_relaxed);
+        blocks.fetch_sub(1, std::memory_order_relaxed);
+    }
+};
+
+// One counter per area, plus the sum of all areas (whose peak is the true
+// combined peak, not the sum of the per-area peaks)
+inline MemoryCounter memoryCounters[static_cast<std::size_t>(MemoryArea::Count)];
+inline MemoryCounter memoryTotal;
+
+inline MemoryCounter& memoryCounter(MemoryArea area) {
+    return memoryCounters[static_cast<std::size_t>(area)];
+}
+
+inline const char* memoryAreaName(MemoryArea area) {
+    static const char* const names[] = {
+        "people", "roomsnums", "reservations", "guestToRooms",
+        "guestHistory", "occupied room tree", "bookingHistory", "RoomType::guests",
+        "calendar", "snapshot chunks", "history cache"
+    };
+    return names[static_cast<std::size_t>(area)];
+}
+
+// Heap buffer owned by a string (0 while it fits in the inline buffer)
+inline long long heapBytes(const std::string& s) {
+    const char* self = reinterpret_cast<const char*>(&s);
+    if (s.data() >= self && s.data() < self + sizeof(s)) return 0;
+    return static_cast<long long>(s.capacity()) + 1;
+}
+
+template <class T, MemoryArea Area>
+class CountingAllocator {
+public:
+    typedef T value_type;
+
+    // Spelled out: allocator_traits cannot rebind a non-type parameter
+    template <class U>
+    struct rebind {
+        typedef CountingAllocator<U, Area> other;
+    };
+
+    CountingAllocator() noexcept {}
+    template <class U>
+    CountingAllocator(const CountingAllocator<U, Area>&) noexcept {}
+
+    T* allocate(std::size_t n) {
+        T* p = std::allocator<T>().allocate(n);
+        memoryCounter(Area).add(n * sizeof(T));
+        memoryTotal.add(n * sizeof(T));
+        return p;
+    }
+
+    void deallocate(T* p, std::size_t n) noexcept {
+        memoryCounter(Area).remove(n * sizeof(T));
+        memoryTotal.remove(n * sizeof(T));
+        std::allocator<T>().deallocate(p, n);
+    }
+};
+
+template <class T, class U, MemoryArea Area>
+bool operator==(const CountingAllocator<T, Area>&, const CountingAllocator<U, Area>&) {
+    return true;
+}
+
+template <class T, class U, MemoryArea Area>
+bool operator!=(const CountingAllocator<T, Area>&, const CountingAllocator<U, Area>&) {
+    return false;
+}
+
+// Standard containers charged to one area, e.g. Counted<MemoryArea::People>::vector<std::string>
+template <MemoryArea Area>
+struct Counted {
+    template <class T>
+    using allocator = CountingAllocator<T, Area>;
+
+    template <class T>
+    using vector = std::vector<T, allocator<T>>;
+
+    template <class T>
+    using list = std::list<T, allocator<T>>;
+
+    template <class T>
+    using deque = std::deque<T, allocator<T>>;
+
+    template <class K, class V>
+    using map = std::map<K, V, std::less<K>, allocator<std::pair<const K, V>>>;
+
+    template <class K, class V>
+    using unordered_map = std::unordered_map<K, V, std::hash<K>, std::equal_to<K>,
+                                             allocator<std::pair<const K, V>>>;
+};
+
+#endif // MEMORY_ACCOUNTING_H
@@ -0,0 +1,412 @@
+#include "replay.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cinttypes>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <iostream>
+#include <streambuf>
+
+using namespace std;
+
+namespace fs = std::filesystem;
+
+namespace {
+
+const char traceMagic[] = "HOTELTRACE";
+const int traceVersion = 1;
+const size_t maxReportedMismatches = 10;
+
+// ----- State hash (FNV-1a, 64-bit) -----
+
+class Fnv {
+public:
+    void bytes(const void* data, size_t size) {
+        const unsigned char* p = static_cast<const unsigned char*>(data);
+        for (size_t i = 0; i < size; ++i) {
+            state = (state ^ p[i]) * 0x100000001b3ULL;
+        }
+    }
+    void text(const string& s) {
+        number(static_cast<long long>(s.size()));
+        bytes(s.data(), s.size());
+    }
+    void number(long long v) { bytes(&v, sizeof(v)); }
+    void real(double v) { bytes(&v, sizeof(v)); }
+    uint64_t value() const { return state; }
+
+private:
+    uint64_t state = 0xcbf29ce484222325ULL;
+};
+
+// Exact decimal form of a double, so the trace round-trips it
+string formatRevenue(double v) {
+    char buffer[40];
+    std::snprintf(buffer, sizeof(buffer), "%.17g", v);
+    return buffer;
+}
+
+string formatHash(uint64_t v) {
+    char buffer[24];
+    std::snprintf(buffer, sizeof(buffer), "%016" PRIx64, v);
+    return buffer;
+}
+
+vector<string> splitTabs(const string& line) {
+    vector<string> fields;
+    size_t start = 0;
+    for (;;) {
+        size_t tab = line.find('\t', start);
+        fields.push_back(line.substr(start, tab == string::npos ? string::npos : tab - start));
+        if (tab == string::npos) break;
+        start = tab + 1;
+    }
+    return fields;
+}
+
+// A field must not split the line it is written on
+string cleanField(string s) {
+    for (char& c : s) {
+        if (c == '\t' || c == '\n' || c == '\r') c = ' ';
+    }
+    return s;
+}
+
+// Swallows everything written to it (the engine prints on every call)
+class NullBuffer : public std::streambuf {
+protected:
+    int overflow(int c) override { return c; }
+};
+
+} // namespace
+
+uint64_t traceStateHash(const Hotel::Snapshot& view) {
+    Fnv h;
+    h.text(view.loadedDate);
+    h.real(view.totalRevenue);
+    for (const Hotel::Snapshot::TypeAvailability& t : view.roomTypes) {
+        h.text(t.name);
+        h.number(t.totalRooms);
+        h.number(t.availableRooms);
+        h.real(t.pricePerNight);
+    }
+    for (const auto& month : *view.days) {
+        for (const auto& day : *month.second) {
+            h.text(day.first);
+            Hotel::Snapshot::RowChunks::forEach(*day.second, [&h](const Hotel::Reservation& r) {
+                h.text(r.guestName);
+                h.number(r.roomNumber);
+                h.text(r.roomType);
+                h.text(r.stayDate);
+                h.number(r.nights);
+                h.number(r.checkInHour);
+                h.real(r.pricePerNight);
+                h.real(r.totalCost);
+                h.number(r.bookedDay);
+            });
+        }
+    }
+    Hotel::Snapshot::SessionChunks::forEach(view.sessionBookings,
+        [&h](const Hotel::Snapshot::SessionBooking& b) {
+            h.text(b.guestName);
+            h.number(b.roomNumber);
+        });
+    Hotel::Snapshot::NameChunks::forEach(view.guestHistory, [&h](const string& guest) {
+        h.text(guest);
+    });
+    return h.value();
+}
+
+std::unique_ptr<Hotel> makeLayoutHotel(const std::string& layout) {
+    if (layout == "hilton") return std::unique_ptr<Hotel>(new HiltonHotel(122));
+    return nullptr;
+}
+
+// ----- Recording -----
+
+TraceRecorder::TraceRecorder(Hotel& hotel, const std::string& layout, const std::string& path)
+    : hotel(hotel), out(path) {
+    if (!out.is_open()) {
+        error = "unable to open " + path;
+        return;
+    }
+    out << traceMagic << '\t' << traceVersion << '\n'
+        << "LAYOUT\t" << cleanField(layout) << '\n';
+}
+
+TraceRecorder::~TraceRecorder() {
+    finish();
+}
+
+void TraceRecorder::carryFiles(const std::string& date, int nights) {
+    if (!out.is_open()) return;
+
+    // The files an operation on these nights may merge (see
+    // Hotel::stayLookbackDays); a file this trace did not write must
+    // travel with it
+    vector<string> dates;
+    int first = Hotel::dateToDayNumber(date);
+    if (first < 0) {
+        dates.push_back(date);
+    } else {
+        for (int day = first - (Hotel::stayLookbackDays - 1); day < first + std::max(nights, 1); ++day) {
+            if (day >= 0) dates.push_back(Hotel::dayNumberToDate(day));
+        }
+    }
+
+    for (const string& d : dates) {
+        if (!knownDates.insert(d).second) continue;
+        ifstream in(d + ".txt");
+        if (!in.is_open()) continue;
+        vector<string> lines;
+        string line;
+        while (std::getline(in, line)) lines.push_back(line);
+        out << "FILE\t" << cleanField(d) << '\t' << lines.size() << '\n';
+        for (const string& l : lines) out << l << '\n';
+    }
+}
+
+void TraceRecorder::loadFromFile(const std::string& date) {
+    carryFiles(date, 1);
+    hotel.loadFromFile(date);
+    ++operationCount;
+    if (!out.is_open()) return;
+    out << "LOAD\t" << cleanField(date) << '\n';
+    writeState();
+}
+
+int TraceRecorder::reserveRoom(int option, const std::string& guestName, const std::string& startDate,
+                               const std::string& endDate, int startTime, int durationDays) {
+    const string guest = cleanField(guestName);
+    carryFiles(startDate, durationDays);
+    int room = hotel.reserveRoom(option, guest, startDate, endDate, startTime, durationDays);
+    ++operationCount;
+    if (out.is_open()) {
+        out << "RESERVE\t" << option << '\t' << guest << '\t' << cleanField(startDate) << '\t'
+            << cleanField(endDate) << '\t' << startTime << '\t' << durationDays << '\t' << room << '\n';
+    }
+    return room;
+}
+
+bool TraceRecorder::undoLastBooking() {
+    bool undone = hotel.undoLastBooking();
+    ++operationCount;
+    if (out.is_open()) out << "UNDO\t" << (undone ? 1 : 0) << '\n';
+    return undone;
+}
+
+void TraceRecorder::saveToFile(const std::string& date) {
+    hotel.saveToFile(date);
+    ++operationCount;
+    knownDates.insert(date);
+    if (out.is_open()) out << "SAVE\t" << cleanField(date) << '\n';
+}
+
+void TraceRecorder::finish() {
+    if (finished || !out.is_open()) return;
+    finished = true;
+    writeState();
+    out.close();
+    if (!out && error.empty()) error = "unable to write the trace";
+}
+
+void TraceRecorder::writeState() {
+    std::shared_ptr<const Hotel::Snapshot> view = hotel.snapshot();
+    out << "STATE\t" << formatHash(traceStateHash(*view)) << '\t'
+        << formatRevenue(view->totalRevenue) << '\n';
+}
+
+// ----- Replaying -----
+
+TraceReplayer::TraceReplayer(const std::string& path) {
+    ifstream in(path);
+    if (!in.is_open()) {
+        error = "unable to open " + path;
+        return;
+    }
+
+    string line;
+    size_t lineNumber = 1;
+    if (!std::getline(in, line) ||
+        line != string(traceMagic) + "\t" + std::to_string(traceVersion)) {
+        error = path + " is not a version " + std::to_string(traceVersion) + " trace";
+        return;
+    }
+
+    while (std::getline(in, line)) {
+        ++lineNumber;
+        if (line.empty()) continue;
+        vector<string> f = splitTabs(line);
+        const string& command = f[0];
+
+        Op op;
+        op.line = lineNumber;
+        if (command == "LAYOUT" && f.size() == 2) {
+            layoutName = f[1];
+            continue;
+        }
+        else if (command == "FILE" && f.size() == 3) {
+            op.kind = Kind::File;
+            op.date = f[1];
+            long count = std::atol(f[2].c_str());
+            for (long i = 0; i < count && std::getline(in, line); ++i) {
+                ++lineNumber;
+                op.lines.push_back(line);
+            }
+            if (static_cast<long>(op.lines.size()) != count) {
+                error = "line " + std::to_string(op.line) + ": day file cut short";
+                return;
+            }
+        }
+        else if (command == "LOAD" && f.size() == 2) {
+            op.kind = Kind::Load;
+            op.date = f[1];
+        }
+        else if (command == "RESERVE" && f.size() == 8) {
+            op.kind = Kind::Reserve;
+            op.option = std::atoi(f[1].c_str());
+            op.guestName = f[2];
+            op.date = f[3];
+            op.endDate = f[4];
+            op.hour = std::atoi(f[5].c_str());
+            op.nights = std::atoi(f[6].c_str());
+            op.expected = std::atoi(f[7].c_str());
+        }
+        else if (command == "UNDO" && f.size() == 2) {
+            op.kind = Kind::Undo;
+            op.expected = std::atoi(f[1].c_str());
+        }
+        else if (command == "SAVE" && f.size() == 2) {
+            op.kind = Kind::Save;
+            op.date = f[1];
+        }
+        else if (command == "STATE" && f.size() == 3) {
+            op.kind = Kind::State;
+            op.hash = std::strtoull(f[1].c_str(), nullptr, 16);
+            op.revenue = f[2];
+        }
+        else {
+            error = "line " + std::to_string(lineNumber) + ": unrecognized entry";
+            return;
+        }
+        ops.push_back(std::move(op));
+    }
+
+    if (layoutName.empty()) error = path + " names no layout";
+}
+
+size_t TraceReplayer::operations() const {
+    size_t count = 0;
+    for (const Op& op : ops) {
+        if (op.kind != Kind::File && op.kind != Kind::State) ++count;
+    }
+    return count;
+}
+
+ReplayReport TraceReplayer::run(const HotelFactory& factory) const {
+    using Clock = std::chrono::steady_clock;
+
+    ReplayReport report;
+    if (!ok()) {
+        report.error = error;
+        return report;
+    }
+
+    std::error_code ec;
+    const fs::path originalDir = fs::current_path(ec);
+    fs::path scratch;
+    for (int attempt = 0; attempt < 100 && scratch.empty(); ++attempt) {
+        fs::path candidate = fs::temp_directory_path(ec) /
+            ("hotel_replay_" + std::to_string(Clock::now().time_since_epoch().count()));
+        if (fs::create_directory(candidate, ec)) scratch = candidate;
+    }
+    if (scratch.empty() || (fs::current_path(scratch, ec), ec)) {
+        report.error = "unable to create a scratch directory";
+        if (!scratch.empty()) fs::remove_all(scratch, ec);
+        return report;
+    }
+
+    NullBuffer sink;
+    std::streambuf* saved = std::cout.rdbuf(&sink);
+    {
+        std::unique_ptr<Hotel> hotel = factory(layoutName);
+        if (!hotel) report.error = "unknown layout '" + layoutName + "'";
+        // As in the CLI, looked-back days are read through the store
+        else hotel->attachHistory(".");
+
+        auto mismatch = [&report](const Op& op, const string& what) {
+            if (++report.mismatches <= maxReportedMismatches) {
+                report.firstMismatches.push_back("line " + std::to_string(op.line) + ": " + what);
+            }
+        };
+
+        Clock::duration elapsed{};
+        for (size_t i = 0; hotel && i < ops.size(); ++i) {
+            const Op& op = ops[i];
+            if (op.kind == Kind::File) {
+                ofstream file(op.date + ".txt");
+                for (const string& l : op.lines) file << l << '\n';
+                continue;
+            }
+            if (op.kind == Kind::State) {
+                std::shared_ptr<const Hotel::Snapshot> view = hotel->snapshot();
+                ++report.checks;
+                uint64_t hash = traceStateHash(*view);
+                string revenue = formatRevenue(view->totalRevenue);
+                if (hash != op.hash || revenue != op.revenue) {
+                    mismatch(op, "state " + formatHash(hash) + " revenue " + revenue +
+                                 ", trace has " + formatHash(op.hash) + " revenue " + op.revenue);
+                }
+                continue;
+            }
+
+            Clock::time_point start = Clock::now();
+            int result = 0;
+            switch (op.kind) {
+            case Kind::Load:
+                hotel->loadFromFile(op.date);
+                break;
+            case Kind::Reserve:
+                result = hotel->reserveRoom(op.option, op.guestName, op.date, op.endDate, op.hour, op.nights);
+                break;
+            case Kind::Undo:
+                result = hotel->undoLastBooking() ? 1 : 0;
+                break;
+            case Kind::Save:
+                hotel->saveToFile(op.date);
+                break;
+            default:
+                break;
+            }
+            elapsed += Clock::now() - start;
+            ++report.operations;
+
+            if (op.kind == Kind::Reserve) {
+                ++report.checks;
+                if (result != op.expected) {
+                    mismatch(op, "RESERVE " + op.guestName + " on " + op.date + " got room " +
+                                 std::to_string(result) + ", trace has " + std::to_string(op.expected));
+                }
+            }
+            else if (op.kind == Kind::Undo) {
+                ++report.checks;
+                if (result != op.expected) {
+                    mismatch(op, string("UNDO ") + (result ? "undid a booking" : "had nothing to undo") +
+                                 ", trace has " + (op.expected ? "a booking undone" : "nothing to undo"));
+                }
+            }
+        }
+
+        report.millis = std::chrono::duration<double, std::milli>(elapsed).count();
+        if (report.millis > 0) report.opsPerSecond = report.operations * 1000.0 / report.millis;
+        // The hotel may flush on destruction, still inside the scratch directory
+    }
+    std::cout.rdbuf(saved);
+
+    fs::current_path(originalDir, ec);
+    fs::remove_all(scratch, ec);
+    return report;
+}
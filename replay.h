@@ -0,0 +1,139 @@
+#ifndef REPLAY_H
+#define REPLAY_H
+
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <functional>
+#include <memory>
+#include <set>
+#include <string>
+#include <vector>
+
+#include "hotel.h"
+
+// Recorded operation traces, replayed against any engine build.
+//
+// A trace is a text file, one operation per line, fields tab-separated:
+//
+//   HOTELTRACE  1
+//   LAYOUT      <layout name>                 (see makeLayoutHotel)
+//   FILE        <date> <line count>           followed by that many raw lines
+//   LOAD        <date>
+//   RESERVE     <option> <guest> <start date> <end date> <hour> <nights> <room or -1>
+//   UNDO        <1 if a booking was undone, else 0>
+//   SAVE        <date>
+//   STATE       <state hash> <total revenue>
+//
+// FILE carries a day file that existed before recording started, so a
+// replay sees the same history; it is written just before the LOAD or
+// RESERVE that may first read it. STATE follows every LOAD and ends the
+// trace.
+//
+// A replay checks every room assignment, undo outcome and state hash
+// against the trace, and times the operations, so one trace is both a
+// regression test and a benchmark.
+
+// FNV-1a over everything a snapshot shows: loaded date, revenue, per-type
+// availability, every stored row (date order) and the session lists
+uint64_t traceStateHash(const Hotel::Snapshot& view);
+
+// Hotel for a layout named in a trace ("hilton"); nullptr if unknown
+std::unique_ptr<Hotel> makeLayoutHotel(const std::string& layout);
+
+typedef std::function<std::unique_ptr<Hotel>(const std::string& layout)> HotelFactory;
+
+// Performs operations on a hotel and appends each one, with its outcome,
+// to a trace file. The hotel must be freshly constructed (nothing loaded).
+class TraceRecorder {
+public:
+    TraceRecorder(Hotel& hotel, const std::string& layout, const std::string& path);
+
+    // Writes the final STATE line
+    ~TraceRecorder();
+
+    TraceRecorder(const TraceRecorder&) = delete;
+    TraceRecorder& operator=(const TraceRecorder&) = delete;
+
+    bool ok() const { return error.empty(); }
+    const std::string& lastError() const { return error; }
+    size_t operations() const { return operationCount; }
+
+    // Same as the Hotel calls they forward to. Tabs and line breaks in a
+    // guest name become spaces, in the booking as well as in the trace.
+    void loadFromFile(const std::string& date);
+    int reserveRoom(int option, const std::string& guestName, const std::string& startDate,
+                    const std::string& endDate, int startTime, int durationDays);
+    bool undoLastBooking();
+    void saveToFile(const std::string& date);
+
+    // Write the final STATE line and close the trace (also done on destruction)
+    void finish();
+
+private:
+    void writeState();
+
+    // FILE entries for the day files a load or booking of these nights
+    // may read
+    void carryFiles(const std::string& date, int nights);
+
+    Hotel& hotel;
+    std::ofstream out;
+    std::set<std::string> knownDates;   // day files the trace already accounts for
+    size_t operationCount = 0;
+    bool finished = false;
+    std::string error;
+};
+
+// Outcome of one replay
+struct ReplayReport {
+    std::string error;                  // trace or setup problem (nothing replayed)
+    size_t operations = 0;              // LOAD / RESERVE / UNDO / SAVE
+    size_t checks = 0;                  // rooms, undos and states compared
+    size_t mismatches = 0;
+    std::vector<std::string> firstMismatches;   // up to ten, with trace line numbers
+    double millis = 0.0;                // operations only (not state hashing)
+    double opsPerSecond = 0.0;
+
+    bool passed() const { return error.empty() && mismatches == 0; }
+};
+
+class TraceReplayer {
+public:
+    // Reads and parses the whole trace up front
+    explicit TraceReplayer(const std::string& path);
+
+    bool ok() const { return error.empty(); }
+    const std::string& lastError() const { return error; }
+    const std::string& layout() const { return layoutName; }
+    size_t operations() const;
+
+    // Replay into a fresh hotel inside a new empty scratch directory (the
+    // engine reads and writes day files in the working directory, which is
+    // changed for the duration of the call). Engine output is discarded.
+    ReplayReport run(const HotelFactory& factory = makeLayoutHotel) const;
+
+private:
+    enum class Kind { File, Load, Reserve, Undo, Save, State };
+
+    struct Op {
+        Kind kind;
+        size_t line;                        // in the trace file
+        std::string date;                   // FILE / LOAD / SAVE / RESERVE start
+        std::string endDate;
+        std::string guestName;
+        int option = 0;
+        int hour = 0;
+        int nights = 0;
+        int expected = 0;                   // room, or undo outcome
+        uint64_t hash = 0;
+        std::string revenue;
+        std::vector<std::string> lines;     // FILE contents
+    };
+
+    std::vector<Op> ops;
+    std::string layoutName;
+    std::string error;
+};
+
+#endif // REPLAY_H
@@ -0,0 +1,48 @@
+// Replays a recorded trace (see replay.h) and checks it.
+//
+// Usage: hotel_replay <trace> [repeat]
+//
+// Record a trace with `hotel --record <trace>`. Each run replays the whole
+// trace into a fresh hotel and prints its throughput; the exit status is
+// non-zero if any run differs from the trace.
+#include "replay.h"
+
+#include <cstdlib>
+#include <iostream>
+#include <string>
+
+using namespace std;
+
+int main(int argc, char** argv) {
+    int repeat = argc > 2 ? std::atoi(argv[2]) : 1;
+    if (argc < 2 || repeat < 1) {
+        std::cerr << "Usage: " << argv[0] << " <trace> [repeat]\n";
+        return 1;
+    }
+
+    TraceReplayer replayer(argv[1]);
+    if (!replayer.ok()) {
+        std::cerr << "Unable to read trace: " << replayer.lastError() << "\n";
+        return 1;
+    }
+    std::cout << argv[1] << ": " << replayer.operations() << " operations on layout '"
+              << replayer.layout() << "'\n";
+
+    bool passed = true;
+    for (int run = 1; run <= repeat; ++run) {
+        ReplayReport report = replayer.run();
+        if (!report.error.empty()) {
+            std::cerr << "Replay failed: " << report.error << "\n";
+            return 1;
+        }
+        std::cout << "Run " << run << ": " << report.operations << " operations in "
+                  << static_cast<long long>(report.millis + 0.5) << " ms ("
+                  << static_cast<long long>(report.opsPerSecond + 0.5) << " ops/s), "
+                  << report.checks << " checks, " << report.mismatches << " mismatch(es)\n";
+        for (const std::string& m : report.firstMismatches) {
+            std::cout << "  " << m << "\n";
+        }
+        passed = passed && report.passed();
+    }
+    return passed ? 0 : 2;
+}
@@ -0,0 +1,124 @@
+#include "room_assignment.h"
+
+#include <algorithm>
+#include <climits>
+#include <iterator>
+
+using namespace std;
+
+namespace {
+
+// Gaps with no booking on that side count as this long
+const int openGap = 1 << 20;
+
+} // namespace
+
+RoomCalendar::RoomCalendar(int longStayNights)
+    : longStayNights(longStayNights < 1 ? 1 : longStayNights) {}
+
+void RoomCalendar::clear() {
+    booked.clear();
+}
+
+bool RoomCalendar::gapAround(int roomNumber, int startDay, int endDay,
+                             int& gapBefore, int& gapAfter) const {
+    gapBefore = openGap;
+    gapAfter = openGap;
+
+    auto roomIt = booked.find(roomNumber);
+    if (roomIt == booked.end()) return true;
+    const Stays& stays = roomIt->second;
+
+    // First booking starting at or after our end, and the one before it
+    auto next = stays.lower_bound(endDay);
+    if (next != stays.begin()) {
+        auto prev = std::prev(next);
+        if (prev->second > startDay) return false;   // overlaps
+        gapBefore = startDay - prev->second;
+    }
+    if (next != stays.end()) {
+        gapAfter = next->first - endDay;
+    }
+    return true;
+}
+
+bool RoomCalendar::isFree(int roomNumber, int startDay, int endDay) const {
+    int before, after;
+    return gapAround(roomNumber, startDay, endDay, before, after);
+}
+
+void RoomCalendar::book(int roomNumber, int startDay, int endDay) {
+    if (endDay <= startDay) return;
+    booked[roomNumber][startDay] = endDay;
+}
+
+void RoomCalendar::release(int roomNumber, int startDay, int endDay) {
+    auto roomIt = booked.find(roomNumber);
+    if (roomIt == booked.end()) return;
+    auto it = roomIt->second.find(startDay);
+    if (it != roomIt->second.end() && it->second == endDay) {
+        roomIt->second.erase(it);
+        if (roomIt->second.empty()) booked.erase(roomIt);
+    }
+}
+
+int RoomCalendar::bestFit(const std::vector<int>& candidates, int startDay, int endDay) const {
+    int bestRoom = -1;
+    long bestScore = LONG_MAX;
+
+    for (int room : candidates) {
+        int before, after;
+        if (!gapAround(room, startDay, endDay, before, after)) continue;
+
+        // A gap of 1..longStayNights-1 nights can only be sold to short
+        // stays: heavy penalty. Otherwise tighter is better, and a flush
+        // fit (gap 0) is best of all.
+        long score = 0;
+        for (int gap : { before, after }) {
+            if (gap > 0 && gap < longStayNights) score += 1000000L;
+            score += std::min(gap, 10000);
+        }
+        if (score < bestScore) {
+            bestScore = score;
+            bestRoom = room;
+            // Flush on both sides: no later candidate can do better
+            if (score == 0) break;
+        }
+    }
+    return bestRoom;
+}
+
+int RoomCalendar::firstFit(const std::vector<int>& candidates, int startDay, int endDay) const {
+    for (int room : candidates) {
+        if (isFree(room, startDay, endDay)) return room;
+    }
+    return -1;
+}
+
+size_t RoomCalendar::bookingCount() const {
+    size_t count = 0;
+    for (const auto& room : booked) count += room.second.size();
+    return count;
+}
+
+long RoomCalendar::longStayCapacity(const std::vector<int>& rooms, int fromDay, int toDay) const {
+    long capacity = 0;
+    for (int room : rooms) {
+        int cursor = fromDay;
+        auto roomIt = booked.find(room);
+        if (roomIt != booked.end()) {
+            const Stays& stays = roomIt->second;
+            // Start from the booking that may straddle fromDay
+            auto it = stays.upper_bound(fromDay);
+            if (it != stays.begin()) --it;
+            for (; it != stays.end() && it->first < toDay; ++it) {
+                if (it->second <= cursor) continue;
+                int gap = it->first - cursor;
+                if (gap >= longStayNights) capacity += gap;
+                cursor = std::max(cursor, it->second);
+            }
+        }
+        if (toDay - cursor >= longStayNights) capacity += toDay - cursor;
+    }
+    return capacity;
+}
@@ -0,0 +1,56 @@
+#ifndef ROOM_ASSIGNMENT_H
+#define ROOM_ASSIGNMENT_H
+
+#include <cstddef>
+#include <vector>
+
+#include "memory_accounting.h"
+
+// Stay calendar for room assignment.
+//
+// Every room keeps its booked nights as an ordered map of half-open day
+// intervals [start, end). The free interval around any day is the gap
+// between its two neighbouring bookings, found with one map lookup, so
+// checking a room or measuring the gaps a stay would leave is O(log n).
+class RoomCalendar {
+public:
+    // Stays shorter than this are "short"; gaps below it are hard to sell
+    explicit RoomCalendar(int longStayNights = 3);
+
+    void clear();
+
+    bool isFree(int roomNumber, int startDay, int endDay) const;
+    void book(int roomNumber, int startDay, int endDay);
+    void release(int roomNumber, int startDay, int endDay);
+
+    // Best-fit choice among candidate rooms free for [startDay, endDay):
+    // prefer the room where the stay fits snugly against existing bookings
+    // and leaves no short, unsellable gap. Ties keep candidate order.
+    // One lookup per candidate, stopping at the first flush fit.
+    // Returns -1 if no candidate is free.
+    int bestFit(const std::vector<int>& candidates, int startDay, int endDay) const;
+
+    // First candidate free for [startDay, endDay), or -1 (the old greedy rule)
+    int firstFit(const std::vector<int>& candidates, int startDay, int endDay) const;
+
+    // Free room-nights in [fromDay, toDay) that lie in gaps of at least
+    // longStayNights, i.e. capacity still sellable to long stays
+    long longStayCapacity(const std::vector<int>& rooms, int fromDay, int toDay) const;
+
+    int longStayThreshold() const { return longStayNights; }
+
+    // Booked stays across all rooms
+    std::size_t bookingCount() const;
+
+private:
+    // Free gap around [startDay, endDay) in one room, or false if it overlaps
+    bool gapAround(int roomNumber, int startDay, int endDay,
+                   int& gapBefore, int& gapAfter) const;
+
+    typedef Counted<MemoryArea::Calendar>::map<int, int> Stays;   // start -> end
+
+    int longStayNights;
+    Counted<MemoryArea::Calendar>::unordered_map<int, Stays> booked;   // by room
+};
+
+#endif // ROOM_ASSIGNMENT_H
@@ -0,0 +1,191 @@
+#ifndef ROOM_CATALOG_H
+#define ROOM_CATALOG_H
+
+#include <array>
+#include <cstddef>
+#include <iterator>
+
+// One contiguous block of rooms of the same type, e.g. 101 thru 170.
+// Rooms in a block are connected in a corridor (r <-> r + 1) unless
+// corridor is false.
+struct RoomRangeSpec {
+    const char* typeName;
+    int firstRoom;
+    int lastRoom;
+    double pricePerNight;
+    const char* rangeLabel;
+    bool corridor = true;
+};
+
+// A connection the corridors do not give, e.g. a connecting door, a shared
+// landing or the rooms either side of a stairwell. Links go both ways.
+struct RoomLinkSpec {
+    int room;
+    int otherRoom;
+};
+
+inline constexpr std::array<RoomLinkSpec, 0> noRoomLinks{};
+
+// Compile-time room catalog for a property whose layout never changes.
+//
+// Declare the blocks as a constexpr array, one block per room type, in menu
+// order (the order std::map<std::string, ...> would list the type names):
+//
+//     inline constexpr RoomRangeSpec myRooms[] = { { "Deluxe", 201, 220, 300.0, "201 thru 220" }, ... };
+//     inline constexpr RoomLinkSpec myLinks[] = { { 220, 301 }, ... };   // optional
+//     using MyCatalog = FixedRoomCatalog<myRooms, myLinks>;
+//
+// Room -> type lookup and adjacency (corridors plus links) are generated as
+// static tables indexed by (room - minRoom), so lookups are one array read
+// and allocate nothing.
+template <const auto& Ranges, const auto& Links = noRoomLinks>
+class FixedRoomCatalog {
+public:
+    static constexpr std::size_t typeCount = std::size(Ranges);
+
+    static constexpr int minRoom = [] {
+        int lo = Ranges[0].firstRoom;
+        for (const RoomRangeSpec& r : Ranges) lo = r.firstRoom < lo ? r.firstRoom : lo;
+        return lo;
+    }();
+
+    static constexpr int maxRoom = [] {
+        int hi = Ranges[0].lastRoom;
+        for (const RoomRangeSpec& r : Ranges) hi = r.lastRoom > hi ? r.lastRoom : hi;
+        return hi;
+    }();
+
+    static constexpr int roomCount = [] {
+        int count = 0;
+        for (const RoomRangeSpec& r : Ranges) count += r.lastRoom - r.firstRoom + 1;
+        return count;
+    }();
+
+    static constexpr std::size_t span = static_cast<std::size_t>(maxRoom - minRoom + 1);
+
+    static constexpr std::size_t linkCount = std::size(Links);
+
+    // Most neighbours any room has: two corridor sides plus its links
+    static constexpr int maxNeighbors = [] {
+        int most = 1;
+        for (const RoomRangeSpec& r : Ranges) {
+            for (int room = r.firstRoom; room <= r.lastRoom; ++room) {
+                int count = r.corridor ? (room > r.firstRoom) + (room < r.lastRoom) : 0;
+                for (const RoomLinkSpec& l : Links) count += (l.room == room) + (l.otherRoom == room);
+                most = count > most ? count : most;
+            }
+        }
+        return most;
+    }();
+
+    // A room's neighbours (count == 0 for unknown rooms)
+    struct Neighbors {
+        int count;
+        int rooms[maxNeighbors];
+    };
+
+    // Type index (menu option - 1) for a room, or -1 if the room does not exist
+    static constexpr int typeIndexOf(int roomNumber) {
+        if (roomNumber < minRoom || roomNumber > maxRoom) return -1;
+        return roomToType[static_cast<std::size_t>(roomNumber - minRoom)];
+    }
+
+    static constexpr const Neighbors& neighborsOf(int roomNumber) {
+        if (roomNumber < minRoom || roomNumber > maxRoom) return noNeighbors;
+        return adjacency[static_cast<std::size_t>(roomNumber - minRoom)];
+    }
+
+    static constexpr const RoomRangeSpec& type(std::size_t index) { return Ranges[index]; }
+
+private:
+    // Same ordering as std::string::operator< (char_traits compares unsigned)
+    static constexpr bool typesInMenuOrder = [] {
+        for (std::size_t i = 1; i < typeCount; ++i) {
+            const char* a = Ranges[i - 1].typeName;
+            const char* b = Ranges[i].typeName;
+            while (*a && *a == *b) {
+                ++a;
+                ++b;
+            }
+            if (static_cast<unsigned char>(*a) >= static_cast<unsigned char>(*b)) return false;
+        }
+        return true;
+    }();
+
+    static constexpr bool rangesValidAndDisjoint = [] {
+        for (std::size_t i = 0; i < typeCount; ++i) {
+            if (Ranges[i].firstRoom > Ranges[i].lastRoom) return false;
+            for (std::size_t j = i + 1; j < typeCount; ++j) {
+                if (Ranges[i].firstRoom <= Ranges[j].lastRoom &&
+                    Ranges[j].firstRoom <= Ranges[i].lastRoom) return false;
+            }
+        }
+        return true;
+    }();
+
+    // Both ends exist, differ, and are not already neighbours
+    static constexpr bool linksValid = [] {
+        auto exists = [](int room) {
+            for (const RoomRangeSpec& r : Ranges) {
+                if (room >= r.firstRoom && room <= r.lastRoom) return true;
+            }
+            return false;
+        };
+        auto corridorNeighbors = [](int a, int b) {
+            for (const RoomRangeSpec& r : Ranges) {
+                if (r.corridor && a >= r.firstRoom && a <= r.lastRoom &&
+                    b >= r.firstRoom && b <= r.lastRoom && (a - b == 1 || b - a == 1)) return true;
+            }
+            return false;
+        };
+        for (std::size_t i = 0; i < linkCount; ++i) {
+            const RoomLinkSpec& l = Links[i];
+            if (!exists(l.room) || !exists(l.otherRoom) || l.room == l.otherRoom ||
+                corridorNeighbors(l.room, l.otherRoom)) return false;
+            for (std::size_t j = 0; j < i; ++j) {
+                if ((Links[j].room == l.room && Links[j].otherRoom == l.otherRoom) ||
+                    (Links[j].room == l.otherRoom && Links[j].otherRoom == l.room)) return false;
+            }
+        }
+        return true;
+    }();
+
+    static_assert(typeCount > 0 && typeCount < 128, "catalog needs 1 to 127 room types");
+    static_assert(typesInMenuOrder, "room types must be declared in menu (alphabetical) order");
+    static_assert(rangesValidAndDisjoint, "room ranges must be valid and must not overlap");
+    static_assert(linksValid, "room links must join two different catalog rooms that are not already neighbours");
+
+    static constexpr std::array<signed char, span> roomToType = [] {
+        std::array<signed char, span> table{};
+        for (std::size_t i = 0; i < span; ++i) table[i] = -1;
+        for (std::size_t t = 0; t < typeCount; ++t) {
+            for (int room = Ranges[t].firstRoom; room <= Ranges[t].lastRoom; ++room) {
+                table[static_cast<std::size_t>(room - minRoom)] = static_cast<signed char>(t);
+            }
+        }
+        return table;
+    }();
+
+    static constexpr std::array<Neighbors, span> adjacency = [] {
+        std::array<Neighbors, span> table{};
+        for (const RoomRangeSpec& r : Ranges) {
+            if (!r.corridor) continue;
+            for (int room = r.firstRoom; room <= r.lastRoom; ++room) {
+                Neighbors& n = table[static_cast<std::size_t>(room - minRoom)];
+                if (room > r.firstRoom) n.rooms[n.count++] = room - 1;
+                if (room < r.lastRoom) n.rooms[n.count++] = room + 1;
+            }
+        }
+        for (const RoomLinkSpec& l : Links) {
+            Neighbors& a = table[static_cast<std::size_t>(l.room - minRoom)];
+            Neighbors& b = table[static_cast<std::size_t>(l.otherRoom - minRoom)];
+            a.rooms[a.count++] = l.otherRoom;
+            b.rooms[b.count++] = l.room;
+        }
+        return table;
+    }();
+
+    static constexpr Neighbors noNeighbors{};
+};
+
+#endif // ROOM_CATALOG_H
@@ -0,0 +1,398 @@
+#include "shard.h"
+
+#include <cerrno>
+#include <cstdio>
+#include <cstdlib>
+#include <deque>
+#include <filesystem>
+#include <iostream>
+#include <streambuf>
+#include <sys/socket.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+using namespace std;
+
+// Protocol: one request per line, fields separated by tabs.
+//
+//   RESERVE option guest date nights hour  -> OK room totalCost
+//   UNDO                                   -> OK
+//   REVENUE fromDay toDay                  -> OK rows revenue
+//   GUEST name                             -> OK date room date room ...
+//   SAVE                                   -> OK filesWritten
+//   QUIT                                   -> OK (after saving)
+//
+// Failures reply ERR and a message.
+
+namespace {
+
+// Tabs and newlines would break the framing; names never need them
+string clean(string field) {
+    for (char& c : field) {
+        if (c == '\t' || c == '\n' || c == '\r') c = ' ';
+    }
+    return field;
+}
+
+vector<string> splitFields(const string& line) {
+    vector<string> fields;
+    size_t pos = 0;
+    for (size_t next; (next = line.find('\t', pos)) != string::npos; pos = next + 1) {
+        fields.push_back(line.substr(pos, next - pos));
+    }
+    fields.push_back(line.substr(pos));
+    return fields;
+}
+
+string formatNumber(double value) {
+    char buffer[32];
+    std::snprintf(buffer, sizeof(buffer), "%.17g", value);
+    return buffer;
+}
+
+bool sendAll(int fd, const string& data) {
+    size_t sent = 0;
+    while (sent < data.size()) {
+        ssize_t n = ::send(fd, data.data() + sent, data.size() - sent, MSG_NOSIGNAL);
+        if (n < 0 && errno == EINTR) continue;
+        if (n <= 0) return false;
+        sent += static_cast<size_t>(n);
+    }
+    return true;
+}
+
+// Next line from a socket; `inbox` keeps whatever was read past it
+bool receiveLine(int fd, string& inbox, string& line) {
+    for (;;) {
+        size_t newline = inbox.find('\n');
+        if (newline != string::npos) {
+            line.assign(inbox, 0, newline);
+            inbox.erase(0, newline + 1);
+            return true;
+        }
+        char chunk[4096];
+        ssize_t n = ::read(fd, chunk, sizeof(chunk));
+        if (n < 0 && errno == EINTR) continue;
+        if (n <= 0) return false;
+        inbox.append(chunk, static_cast<size_t>(n));
+    }
+}
+
+// Workers print nothing: Hotel's console output goes here
+class DiscardBuffer : public std::streambuf {
+protected:
+    int overflow(int c) override { return c; }
+};
+
+string handle(Hotel& hotel, const vector<string>& request) {
+    const string& command = request[0];
+
+    if (command == "RESERVE" && request.size() == 6) {
+        const string& date = request[3];
+        double cost = 0.0;
+        int room = hotel.reserveRoom(std::atoi(request[1].c_str()), request[2], date, date,
+                                     std::atoi(request[5].c_str()), std::atoi(request[4].c_str()), &cost);
+        if (room < 0) return "ERR\tno room available";
+        return "OK\t" + to_string(room) + "\t" + formatNumber(cost);
+    }
+    if (command == "UNDO") {
+        return hotel.undoLastBooking() ? "OK" : "ERR\tnothing to undo";
+    }
+    if (command == "REVENUE" && request.size() == 3) {
+        int fromDay = std::atoi(request[1].c_str());
+        int toDay = std::atoi(request[2].c_str());
+        unsigned long long rows = 0;
+        double revenue = 0.0;
+        std::shared_ptr<const Hotel::Snapshot> view = hotel.snapshot();
+        for (const auto& month : *view->days) {
+            for (const auto& day : *month.second) {
+                int dayNumber = Hotel::dateToDayNumber(day.first);
+                if (dayNumber < fromDay || dayNumber > toDay) continue;
+                Hotel::Snapshot::RowChunks::forEach(*day.second, [&](const Hotel::Reservation& r) {
+                    ++rows;
+                    revenue += r.totalCost;
+                });
+            }
+        }
+        return "OK\t" + to_string(rows) + "\t" + formatNumber(revenue);
+    }
+    if (command == "GUEST" && request.size() == 2) {
+        string reply = "OK";
+        std::shared_ptr<const Hotel::Snapshot> view = hotel.snapshot();
+        for (const auto& month : *view->days) {
+            for (const auto& day : *month.second) {
+                Hotel::Snapshot::RowChunks::forEach(*day.second, [&](const Hotel::Reservation& r) {
+                    if (r.guestName == request[1]) {
+                        reply += "\t" + r.stayDate + "\t" + to_string(r.roomNumber);
+                    }
+                });
+            }
+        }
+        return reply;
+    }
+    if (command == "SAVE") {
+        return "OK\t" + to_string(hotel.flushDirty());
+    }
+    return "ERR\tunknown request " + command;
+}
+
+// Worker process main loop: serve requests until QUIT or the coordinator goes away
+void runWorker(int fd, const ShardSpec& spec) {
+    DiscardBuffer discard;
+    std::cout.rdbuf(&discard);
+
+    std::error_code ec;
+    std::filesystem::create_directories(spec.directory, ec);
+    std::filesystem::current_path(spec.directory, ec);
+    if (ec) {
+        sendAll(fd, "ERR\tcannot use directory " + spec.directory + "\n");
+        return;
+    }
+
+    std::unique_ptr<Hotel> hotel = spec.makeHotel ? spec.makeHotel()
+                                                  : std::unique_ptr<Hotel>(new HiltonHotel(122));
+    if (!spec.loadedDate.empty()) hotel->loadFromFile(spec.loadedDate);
+    // Revenue and guest queries answer from every stay in the shard's
+    // directory, including those saved before a restart
+    hotel->attachHistory(".");
+    hotel->importDirectory(".");
+    if (!sendAll(fd, "OK\tready\n")) return;
+
+    string inbox, line;
+    while (receiveLine(fd, inbox, line)) {
+        vector<string> request = splitFields(line);
+        if (request[0] == "QUIT") {
+            hotel->flushDirty();
+            sendAll(fd, "OK\n");
+            return;
+        }
+        if (!sendAll(fd, handle(*hotel, request) + "\n")) break;
+    }
+    hotel->flushDirty();
+}
+
+ShardCoordinator::Reply parseReply(const string& line) {
+    ShardCoordinator::Reply reply;
+    vector<string> fields = splitFields(line);
+    if (fields[0] == "OK") {
+        reply.ok = true;
+        reply.fields.assign(fields.begin() + 1, fields.end());
+    } else {
+        reply.error = fields.size() > 1 ? fields[1] : line;
+    }
+    return reply;
+}
+
+} // namespace
+
+struct ShardCoordinator::Shard {
+    ShardSpec spec;
+    pid_t pid = -1;
+    int fd = -1;
+    string inbox;
+    bool alive = false;
+
+    bool send(const string& request) {
+        if (alive && !sendAll(fd, request + "\n")) alive = false;
+        return alive;
+    }
+
+    Reply receive() {
+        string line;
+        if (!alive || !receiveLine(fd, inbox, line)) {
+            alive = false;
+            Reply reply;
+            reply.error = "shard " + spec.property + " is not responding";
+            return reply;
+        }
+        return parseReply(line);
+    }
+};
+
+ShardCoordinator::ShardCoordinator(const vector<ShardSpec>& specs) {
+    // Anything still buffered would be written again by every child
+    std::cout.flush();
+    std::fflush(nullptr);
+
+    for (const ShardSpec& spec : specs) {
+        std::unique_ptr<Shard> shard(new Shard);
+        shard->spec = spec;
+
+        int fds[2];
+        if (::socketpair(AF_UNIX, SOCK_STREAM, 0, fds) != 0) {
+            error = "socketpair failed";
+            break;
+        }
+        pid_t pid = ::fork();
+        if (pid < 0) {
+            ::close(fds[0]);
+            ::close(fds[1]);
+            error = "fork failed";
+            break;
+        }
+        if (pid == 0) {
+            // Worker: keep only its own end of its own socket
+            ::close(fds[0]);
+            for (const auto& other : shards) ::close(other->fd);
+            runWorker(fds[1], spec);
+            ::close(fds[1]);
+            ::_exit(0);
+        }
+
+        ::close(fds[1]);
+        shard->pid = pid;
+        shard->fd = fds[0];
+        shard->alive = true;
+        shards.push_back(std::move(shard));
+    }
+
+    // Wait until every worker has loaded its hotel
+    for (const auto& shard : shards) {
+        Reply ready = shard->receive();
+        if (!ready.ok && ok()) error = "shard " + shard->spec.property + ": " + ready.error;
+    }
+}
+
+ShardCoordinator::~ShardCoordinator() {
+    for (const auto& shard : shards) shard->send("QUIT");
+    for (const auto& shard : shards) {
+        if (shard->alive) shard->receive();
+        ::close(shard->fd);
+        int status = 0;
+        ::waitpid(shard->pid, &status, 0);
+    }
+}
+
+int ShardCoordinator::route(const string& property, const string& date) const {
+    int day = Hotel::dateToDayNumber(date);
+    for (size_t i = 0; i < shards.size(); ++i) {
+        const ShardSpec& spec = shards[i]->spec;
+        if (spec.property != property) continue;
+        if (spec.fromDay >= 0 && day < spec.fromDay) continue;
+        if (spec.toDay >= 0 && (day < 0 || day > spec.toDay)) continue;
+        return static_cast<int>(i);
+    }
+    return -1;
+}
+
+ShardCoordinator::BookingResult ShardCoordinator::reserve(const Booking& booking) {
+    return reserveBatch({ booking }).front();
+}
+
+vector<ShardCoordinator::BookingResult> ShardCoordinator::reserveBatch(const vector<Booking>& bookings,
+                                                                       size_t window) {
+    vector<BookingResult> results(bookings.size());
+    vector<std::deque<size_t>> inflight(shards.size());
+    window = std::max<size_t>(window, 1);
+
+    auto complete = [&](size_t s) {
+        size_t i = inflight[s].front();
+        inflight[s].pop_front();
+        Reply reply = shards[s]->receive();
+        results[i].ok = reply.ok && reply.fields.size() == 2;
+        if (results[i].ok) {
+            results[i].roomNumber = std::atoi(reply.fields[0].c_str());
+            results[i].totalCost = std::atof(reply.fields[1].c_str());
+        } else {
+            results[i].error = reply.error;
+        }
+    };
+
+    for (size_t i = 0; i < bookings.size(); ++i) {
+        const Booking& b = bookings[i];
+        int s = route(b.property, b.date);
+        results[i].shard = s;
+        if (s < 0) {
+            results[i].error = "no shard for " + b.property + " on " + b.date;
+            continue;
+        }
+        const ShardSpec& spec = shards[s]->spec;
+        int lastNight = Hotel::dateToDayNumber(b.date) + std::max(b.nights, 1) - 1;
+        if (spec.toDay >= 0 && lastNight > spec.toDay) {
+            results[i].error = "stay runs past the last day of its shard";
+            continue;
+        }
+
+        if (inflight[s].size() >= window) complete(static_cast<size_t>(s));
+        string request = "RESERVE\t" + to_string(b.option) + "\t" + clean(b.guestName) + "\t" +
+                         clean(b.date) + "\t" + to_string(b.nights) + "\t" + to_string(b.checkInHour);
+        if (!shards[s]->send(request)) {
+            results[i].error = "shard " + spec.property + " is not responding";
+            continue;
+        }
+        inflight[s].push_back(i);
+    }
+    for (size_t s = 0; s < shards.size(); ++s) {
+        while (!inflight[s].empty()) complete(s);
+    }
+
+    // Each shard undoes its own bookings last-first; remember them in request order
+    for (const BookingResult& result : results) {
+        if (result.ok) undoShards.push_back(result.shard);
+    }
+    return results;
+}
+
+ShardCoordinator::Reply ShardCoordinator::undoLastBooking() {
+    if (undoShards.empty()) {
+        Reply reply;
+        reply.error = "nothing to undo";
+        return reply;
+    }
+    Reply reply = scatter({ static_cast<size_t>(undoShards.back()) }, "UNDO").front();
+    if (reply.ok) undoShards.pop_back();
+    return reply;
+}
+
+vector<ShardCoordinator::Reply> ShardCoordinator::scatter(const vector<size_t>& targets,
+                                                          const string& request) {
+    for (size_t s : targets) shards[s]->send(request);
+    vector<Reply> replies;
+    replies.reserve(targets.size());
+    for (size_t s : targets) replies.push_back(shards[s]->receive());
+    return replies;
+}
+
+ShardCoordinator::RevenueReport ShardCoordinator::portfolioRevenue(int fromDay, int toDay) {
+    vector<size_t> all;
+    for (size_t s = 0; s < shards.size(); ++s) all.push_back(s);
+
+    RevenueReport report;
+    for (const Reply& reply : scatter(all, "REVENUE\t" + to_string(fromDay) + "\t" + to_string(toDay))) {
+        double revenue = 0.0;
+        if (reply.ok && reply.fields.size() == 2) {
+            report.rows += std::strtoull(reply.fields[0].c_str(), nullptr, 10);
+            revenue = std::atof(reply.fields[1].c_str());
+        }
+        report.byShard.push_back(revenue);
+        report.revenue += revenue;
+    }
+    return report;
+}
+
+vector<ShardCoordinator::GuestStay> ShardCoordinator::findGuest(const string& guestName) {
+    vector<size_t> all;
+    for (size_t s = 0; s < shards.size(); ++s) all.push_back(s);
+
+    vector<GuestStay> stays;
+    vector<Reply> replies = scatter(all, "GUEST\t" + clean(guestName));
+    for (size_t s = 0; s < replies.size(); ++s) {
+        const vector<string>& fields = replies[s].fields;
+        for (size_t f = 0; f + 1 < fields.size(); f += 2) {
+            stays.push_back({ static_cast<int>(s), shards[s]->spec.property, fields[f],
+                              std::atoi(fields[f + 1].c_str()) });
+        }
+    }
+    return stays;
+}
+
+size_t ShardCoordinator::saveAll() {
+    vector<size_t> all;
+    for (size_t s = 0; s < shards.size(); ++s) all.push_back(s);
+
+    size_t written = 0;
+    for (const Reply& reply : scatter(all, "SAVE")) {
+        if (reply.ok && !reply.fields.empty()) written += std::strtoul(reply.fields[0].c_str(), nullptr, 10);
+    }
+    return written;
+}
@@ -0,0 +1,124 @@
+#ifndef SHARD_H
+#define SHARD_H
+
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <string>
+#include <sys/types.h>
+#include <vector>
+
+#include "hotel.h"
+
+// Multi-process deployment on one machine (POSIX only).
+//
+// A ShardCoordinator forks one worker process per shard. Each worker owns
+// one Hotel, keeps its day files in its own directory, and serves requests
+// over a Unix socket pair on a single thread, one line per request and one
+// line per reply (tab-separated fields; see shard.cpp for the commands).
+//
+// A shard is one property, or one range of arrival dates of a property.
+// Bookings go to the shard that owns their property and arrival date.
+// Portfolio queries (revenue, guest lookup) are sent to every shard first
+// and their replies gathered afterwards, so the shards work in parallel.
+//
+// Date-range shards each keep their own calendar, so a stay whose nights
+// run past its shard's last day is rejected rather than risk a double
+// booking in the next shard.
+struct ShardSpec {
+    std::string property;
+    std::string directory;          // day files of this shard
+    std::string loadedDate;         // date loaded at start ("today")
+    int fromDay = -1;               // arrival days owned; -1 = unbounded
+    int toDay = -1;
+
+    // Builds the worker's hotel (after fork, inside the worker)
+    std::function<std::unique_ptr<Hotel>()> makeHotel;
+};
+
+class ShardCoordinator {
+public:
+    struct Reply {
+        bool ok = false;
+        std::vector<std::string> fields;    // on success
+        std::string error;                  // on failure
+    };
+
+    struct Booking {
+        std::string property;
+        int option;                         // room type, 1-based menu order
+        std::string guestName;
+        std::string date;                   // arrival, MM-DD-YYYY
+        int nights;
+        int checkInHour;
+    };
+
+    struct BookingResult {
+        bool ok = false;
+        int shard = -1;
+        int roomNumber = -1;
+        double totalCost = 0.0;
+        std::string error;
+    };
+
+    struct GuestStay {
+        int shard;
+        std::string property;
+        std::string date;
+        int roomNumber;
+    };
+
+    struct RevenueReport {
+        unsigned long long rows = 0;
+        double revenue = 0.0;
+        std::vector<double> byShard;
+    };
+
+    // Forks one worker per spec. Create the coordinator before starting
+    // any threads in this process.
+    explicit ShardCoordinator(const std::vector<ShardSpec>& shards);
+
+    // Saves every shard's changes and stops the workers
+    ~ShardCoordinator();
+
+    ShardCoordinator(const ShardCoordinator&) = delete;
+    ShardCoordinator& operator=(const ShardCoordinator&) = delete;
+
+    bool ok() const { return error.empty(); }
+    const std::string& lastError() const { return error; }
+    size_t shardCount() const { return shards.size(); }
+
+    // Shard that owns a property's arrival date (-1 if none)
+    int route(const std::string& property, const std::string& date) const;
+
+    BookingResult reserve(const Booking& booking);
+
+    // Route and send a batch, keeping up to `window` requests in flight per
+    // shard; results come back in request order
+    std::vector<BookingResult> reserveBatch(const std::vector<Booking>& bookings,
+                                            size_t window = 64);
+
+    // Undo the most recent successful reservation made through this coordinator
+    Reply undoLastBooking();
+
+    // Scatter-gather: revenue of stays arriving in [fromDay, toDay] on every shard
+    RevenueReport portfolioRevenue(int fromDay, int toDay);
+
+    // Scatter-gather: every stored stay of a guest, on every shard
+    std::vector<GuestStay> findGuest(const std::string& guestName);
+
+    // Write every shard's unsaved dates; returns files written
+    size_t saveAll();
+
+private:
+    struct Shard;
+
+    // Send one request line to each listed shard, then read one reply from each
+    std::vector<Reply> scatter(const std::vector<size_t>& targets, const std::string& request);
+
+    std::vector<std::unique_ptr<Shard>> shards;
+    std::vector<int> undoShards;            // shard of each undoable reservation
+    std::string error;
+};
+
+#endif // SHARD_H
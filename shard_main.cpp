@@ -0,0 +1,117 @@
+// Coordinator front end for a sharded deployment (see shard.h).
+//
+// Usage: hotel_shards <today MM-DD-YYYY> <properties> [date ranges per property]
+//
+// Starts one worker per property (P1, P2, ...), or per 90-day range of
+// arrival dates of each property, keeping day files under shards/<name>.
+// Commands are read from standard input, one per line:
+//
+//   reserve <property> <room option> <date> <nights> <hour> <guest name>
+//   undo
+//   revenue <from date> <to date>
+//   guest <guest name>
+//   save
+//   quit
+#include "shard.h"
+
+#include <cstdlib>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+int main(int argc, char** argv) {
+    int today = argc > 2 ? Hotel::dateToDayNumber(argv[1]) : -1;
+    int properties = argc > 2 ? std::atoi(argv[2]) : 0;
+    int ranges = argc > 3 ? std::atoi(argv[3]) : 1;
+    if (today < 0 || properties < 1 || ranges < 1) {
+        std::cerr << "Usage: " << argv[0] << " <today MM-DD-YYYY> <properties> [date ranges per property]\n";
+        return 1;
+    }
+
+    const int rangeDays = 90;
+    std::vector<ShardSpec> specs;
+    for (int p = 1; p <= properties; ++p) {
+        for (int r = 0; r < ranges; ++r) {
+            ShardSpec spec;
+            spec.property = "P" + std::to_string(p);
+            spec.directory = "shards/" + spec.property + (ranges > 1 ? "-" + std::to_string(r + 1) : "");
+            spec.loadedDate = argv[1];
+            // First range also owns the past, last range the far future
+            spec.fromDay = r == 0 ? -1 : today + r * rangeDays;
+            spec.toDay = r == ranges - 1 ? -1 : today + (r + 1) * rangeDays - 1;
+            specs.push_back(spec);
+        }
+    }
+
+    ShardCoordinator coordinator(specs);
+    if (!coordinator.ok()) {
+        std::cerr << "Unable to start shards: " << coordinator.lastError() << "\n";
+        return 1;
+    }
+    std::cout << "Started " << coordinator.shardCount() << " shard(s).\n";
+
+    std::string line;
+    while (std::cout << "> " << std::flush, std::getline(std::cin, line)) {
+        std::istringstream in(line);
+        std::string command;
+        in >> command;
+
+        if (command == "reserve") {
+            ShardCoordinator::Booking booking;
+            in >> booking.property >> booking.option >> booking.date >> booking.nights >> booking.checkInHour;
+            std::getline(in >> std::ws, booking.guestName);
+            if (!in && booking.guestName.empty()) {
+                std::cout << "Usage: reserve <property> <room option> <date> <nights> <hour> <guest name>\n";
+                continue;
+            }
+            ShardCoordinator::BookingResult result = coordinator.reserve(booking);
+            if (result.ok) {
+                std::cout << "Reserved room " << result.roomNumber << " at " << booking.property
+                          << " (shard " << result.shard + 1 << ") for $" << result.totalCost << "\n";
+            } else {
+                std::cout << "Reservation failed: " << result.error << "\n";
+            }
+        }
+        else if (command == "undo") {
+            ShardCoordinator::Reply reply = coordinator.undoLastBooking();
+            std::cout << (reply.ok ? std::string("Last booking undone.") : "Undo failed: " + reply.error) << "\n";
+        }
+        else if (command == "revenue") {
+            std::string from, to;
+            in >> from >> to;
+            int fromDay = Hotel::dateToDayNumber(from);
+            int toDay = Hotel::dateToDayNumber(to);
+            if (fromDay < 0 || toDay < 0) {
+                std::cout << "Usage: revenue <from MM-DD-YYYY> <to MM-DD-YYYY>\n";
+                continue;
+            }
+            ShardCoordinator::RevenueReport report = coordinator.portfolioRevenue(fromDay, toDay);
+            for (size_t s = 0; s < report.byShard.size(); ++s) {
+                std::cout << "  " << specs[s].directory << ": $" << report.byShard[s] << "\n";
+            }
+            std::cout << "Portfolio: " << report.rows << " reservations, $" << report.revenue << "\n";
+        }
+        else if (command == "guest") {
+            std::string guest;
+            std::getline(in >> std::ws, guest);
+            std::vector<ShardCoordinator::GuestStay> stays = coordinator.findGuest(guest);
+            if (stays.empty()) std::cout << "No reservations for " << guest << ".\n";
+            for (const ShardCoordinator::GuestStay& stay : stays) {
+                std::cout << "  " << stay.property << "  " << stay.date << "  Room " << stay.roomNumber << "\n";
+            }
+        }
+        else if (command == "save") {
+            std::cout << coordinator.saveAll() << " file(s) written.\n";
+        }
+        else if (command == "quit" || command == "exit") {
+            break;
+        }
+        else if (!command.empty()) {
+            std::cout << "Commands: reserve, undo, revenue, guest, save, quit\n";
+        }
+    }
+    return 0;
+}
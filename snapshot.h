@@ -0,0 +1,170 @@
+#ifndef SNAPSHOT_H
+#define SNAPSHOT_H
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <utility>
+#include <vector>
+
+// Append-mostly sequence shared with published read-only snapshots.
+//
+// Elements live in chunks of fixed capacity: small at first (so the many
+// short sequences, like one date's rows, stay small) and doubling up to
+// ChunkSize. freeze() hands
+// out the chunk pointers and how many elements of each are visible, without
+// copying any element. Appending writes past every frozen size into space
+// that is already allocated, so it never copies; set() and erase() copy the
+// one chunk they touch while a frozen view still holds it. A frozen view
+// therefore never changes.
+//
+// The list of all but the last chunk is itself shared between views and
+// only rebuilt when a chunk fills up or an older chunk changes, so freeze()
+// is O(1) amortized even for long sequences.
+//
+// Only one thread may call the non-const members. Chunks are allocated
+// with Alloc (see memory_accounting.h).
+template <class T, std::size_t ChunkSize = 64, class Alloc = std::allocator<T>>
+class CowChunks {
+public:
+    typedef std::vector<T, Alloc> Chunk;
+
+    struct FrozenChunk {
+        std::shared_ptr<const Chunk> items;
+        std::size_t size;                       // elements visible in this view
+    };
+
+    struct Frozen {
+        std::shared_ptr<const std::vector<FrozenChunk>> sealed;   // all but the last chunk
+        FrozenChunk tail;                                          // items == nullptr if empty
+
+        bool empty() const { return !tail.items; }
+    };
+
+    std::size_t size() const { return count; }
+
+    void clear() {
+        chunks.clear();
+        sealed.reset();
+        count = 0;
+    }
+
+    void push_back(const T& value) {
+        grow();
+        chunks.back()->push_back(value);
+        ++count;
+    }
+
+    void push_back(T&& value) {
+        grow();
+        chunks.back()->push_back(std::move(value));
+        ++count;
+    }
+
+    // Element at a position (0-based over the whole sequence)
+    const T& at(std::size_t index) const {
+        std::size_t chunk = locate(index);
+        return (*chunks[chunk])[index];
+    }
+
+    // Visit every current element in order, without freezing
+    template <class Fn>
+    void forEachLive(Fn fn) const {
+        for (const std::shared_ptr<Chunk>& chunk : chunks) {
+            for (const T& item : *chunk) fn(item);
+        }
+    }
+
+    // Replace the element at a position (0-based over the whole sequence)
+    void set(std::size_t index, const T& value) {
+        std::size_t chunk = locate(index);
+        if (chunk >= chunks.size()) return;
+        writable(chunk)[index] = value;
+        if (chunk + 1 < chunks.size()) sealed.reset();
+    }
+
+    // Remove the element at a position; later elements move up one
+    void erase(std::size_t index) {
+        std::size_t chunk = locate(index);
+        if (chunk >= chunks.size()) return;
+        Chunk& items = writable(chunk);
+        items.erase(items.begin() + static_cast<std::ptrdiff_t>(index));
+        if (chunk + 1 < chunks.size()) sealed.reset();
+        if (items.empty()) {
+            chunks.erase(chunks.begin() + static_cast<std::ptrdiff_t>(chunk));
+            sealed.reset();
+        }
+        --count;
+    }
+
+    Frozen freeze() const {
+        Frozen view;
+        if (chunks.empty()) return view;
+        if (!sealed || sealed->size() != chunks.size() - 1) {
+            auto rebuilt = std::make_shared<std::vector<FrozenChunk>>();
+            rebuilt->reserve(chunks.size() - 1);
+            for (std::size_t i = 0; i + 1 < chunks.size(); ++i) {
+                rebuilt->push_back({ chunks[i], chunks[i]->size() });
+            }
+            sealed = rebuilt;
+        }
+        view.sealed = sealed;
+        view.tail = { chunks.back(), chunks.back()->size() };
+        return view;
+    }
+
+    // Visit every element of a frozen view in order
+    template <class Fn>
+    static void forEach(const Frozen& view, Fn fn) {
+        if (view.sealed) {
+            for (const FrozenChunk& chunk : *view.sealed) visit(chunk, fn);
+        }
+        if (view.tail.items) visit(view.tail, fn);
+    }
+
+private:
+    // Room for one more element at the back
+    void grow() {
+        if (chunks.empty() || chunks.back()->size() >= chunks.back()->capacity()) {
+            chunks.push_back(std::allocate_shared<Chunk>(Alloc()));
+            chunks.back()->reserve(std::min(ChunkSize, std::max<std::size_t>(4, count)));
+        }
+    }
+
+    template <class Fn>
+    static void visit(const FrozenChunk& chunk, Fn& fn) {
+        const T* items = chunk.items->data();
+        for (std::size_t i = 0; i < chunk.size; ++i) fn(items[i]);
+    }
+
+    // Chunk holding element `index` (index becomes the offset inside it)
+    std::size_t locate(std::size_t& index) const {
+        std::size_t chunk = 0;
+        while (chunk < chunks.size() && index >= chunks[chunk]->size()) {
+            index -= chunks[chunk]->size();
+            ++chunk;
+        }
+        return chunk;
+    }
+
+    Chunk& writable(std::size_t chunk) {
+        // Views only get chunks through freeze() on this thread, so a count
+        // of 1 cannot go up behind our back. The fence orders our writes
+        // after a reader's last use of a chunk it just released.
+        if (chunks[chunk].use_count() > 1) {
+            auto copy = std::allocate_shared<Chunk>(Alloc());
+            copy->reserve(chunks[chunk]->capacity());
+            copy->assign(chunks[chunk]->begin(), chunks[chunk]->end());
+            chunks[chunk] = copy;
+        }
+        std::atomic_thread_fence(std::memory_order_acquire);
+        return *chunks[chunk];
+    }
+
+    std::vector<std::shared_ptr<Chunk>> chunks;
+    mutable std::shared_ptr<const std::vector<FrozenChunk>> sealed;   // cached for freeze()
+    std::size_t count = 0;
+};
+
+#endif // SNAPSHOT_H
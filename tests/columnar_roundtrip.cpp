@@ -0,0 +1,122 @@
+// A columnar export must hold the same rows as the hotel it came from, and
+// a date-range scan must read only the row groups that can match.
+//
+// Usage: hotel_columnar_test
+#include "columnar.h"
+#include "hotel.h"
+#include "test_support.h"
+
+#include <climits>
+#include <cmath>
+#include <iostream>
+#include <set>
+#include <sstream>
+#include <string>
+
+using namespace std;
+
+namespace {
+
+std::string rowText(const Hotel::Reservation& r) {
+    std::ostringstream line;
+    line << r.stayDate << " | " << r.roomNumber << " | " << r.roomType << " | "
+         << r.guestName << " | " << r.nights << " | " << r.checkInHour << " | "
+         << r.pricePerNight << " | " << r.totalCost << " | " << r.bookedDay;
+    return line.str();
+}
+
+// Stored rows of a hotel whose stay day lies in [fromDay, toDay]
+std::multiset<std::string> storedRows(Hotel& hotel, int fromDay, int toDay, double& revenue) {
+    std::multiset<std::string> rows;
+    revenue = 0.0;
+    std::shared_ptr<const Hotel::Snapshot> view = hotel.snapshot();
+    for (const auto& month : *view->days) {
+        for (const auto& day : *month.second) {
+            Hotel::Snapshot::RowChunks::forEach(*day.second, [&](const Hotel::Reservation& r) {
+                int stayDay = Hotel::dateToDayNumber(r.stayDate);
+                if (stayDay < fromDay || stayDay > toDay) return;
+                rows.insert(rowText(r));
+                revenue += r.totalCost;
+            });
+        }
+    }
+    return rows;
+}
+
+std::multiset<std::string> scannedRows(ColumnarReader& reader, int fromDay, int toDay,
+                                       ColumnarReader::ScanStats& stats) {
+    std::multiset<std::string> rows;
+    stats = reader.scan(fromDay, toDay, [&rows](const Hotel::Reservation& r) { rows.insert(rowText(r)); });
+    return rows;
+}
+
+bool same(double a, double b) { return std::abs(a - b) <= 1e-6 * std::max(1.0, std::abs(b)); }
+
+} // namespace
+
+int main() {
+    ScratchDir scratch("hotel_columnar_test");
+    const std::string first = "03-01-2026";
+    const int firstDay = Hotel::dateToDayNumber(first);
+    const int days = 90;
+
+    // Three stays a night of different types and lengths, some guests with commas
+    HiltonHotel hotel(122);
+    hotel.loadFromFile(first);
+    for (int day = firstDay; day < firstDay + days; ++day) {
+        const std::string date = Hotel::dayNumberToDate(day);
+        hotel.reserveRoom(1 + day % 4, "Guest " + std::to_string(day), date, date, 15, 1);
+        hotel.reserveRoom(4, "Lovelace, Ada", date, date, 9 + day % 12, 1 + day % 3);
+        hotel.reserveRoom(2, "Babbage", date, date, 15, 2);
+    }
+    double storedRevenue = 0.0;
+    const std::multiset<std::string> all = storedRows(hotel, INT_MIN, INT_MAX, storedRevenue);
+    expect(all.size() >= static_cast<size_t>(days), "the hotel booked the stays");
+
+    // Small row groups so a range covers only a few of them
+    Hotel::ExportReport report = hotel.exportColumnar("all.hcol", 32);
+    expect(report.ok && report.rows == all.size(), "export writes every stored row");
+
+    ColumnarReader reader("all.hcol");
+    expect(reader.ok(), "the export reads back: " + reader.lastError());
+    expect(reader.rowCount() == all.size(), "the footer counts every row");
+    expect(reader.rowGroups().size() > 4, "the export has several row groups");
+
+    ColumnarReader::ScanStats stats;
+    expect(scannedRows(reader, INT_MIN, INT_MAX, stats) == all, "a full scan returns the stored rows");
+    expect(stats.groupsSkipped == 0 && same(stats.revenue, storedRevenue), "a full scan reads every group");
+
+    // Pushdown: one week reads only the groups whose days overlap it
+    const int weekFrom = firstDay + 40, weekTo = firstDay + 46;
+    double weekRevenue = 0.0;
+    const std::multiset<std::string> week = storedRows(hotel, weekFrom, weekTo, weekRevenue);
+    expect(scannedRows(reader, weekFrom, weekTo, stats) == week, "a week's scan returns that week's rows");
+    expect(stats.groupsSkipped > 0 && stats.groupsRead < reader.rowGroups().size(),
+           "a week's scan skips the groups outside it");
+    expect(same(stats.revenue, weekRevenue), "a week's scan sums that week's revenue");
+
+    // Groups wholly inside the range are answered from their statistics
+    const RowGroupInfo& second = reader.rowGroups()[1];
+    const RowGroupInfo& third = reader.rowGroups()[2];
+    double rangeRevenue = 0.0;
+    storedRows(hotel, second.minDay, third.maxDay, rangeRevenue);
+    stats = reader.revenue(second.minDay, third.maxDay);
+    expect(stats.groupsFromStatistics >= 2, "revenue uses the statistics of groups inside the range");
+    expect(same(stats.revenue, rangeRevenue), "revenue from statistics matches the stored rows");
+
+    // The day files convert to the same rows
+    hotel.flushDirty();
+    report = Hotel::exportDirectoryColumnar(".", "files.hcol", 32);
+    ColumnarReader files("files.hcol");
+    expect(report.ok && files.ok(), "the day files export");
+    expect(scannedRows(files, INT_MIN, INT_MAX, stats) == all, "the day files' export holds the stored rows");
+
+    // A file from another format version is refused
+    std::string bytes = readFile("all.hcol");
+    bytes[4] = 2;
+    writeFile("other.hcol", bytes);
+    expect(!ColumnarReader("other.hcol").ok(), "an unknown format version is refused");
+
+    std::cout << "columnar: " << failures() << " failure(s)\n";
+    return failures() == 0 ? 0 : 1;
+}
@@ -0,0 +1,83 @@
+// A forecast reads the day files but must not change the hotel: no row
+// is merged into memory, and rows merged later are not counted twice.
+//
+// Usage: hotel_forecast_test
+#include "hotel.h"
+#include "test_support.h"
+
+#include <cmath>
+#include <iostream>
+#include <memory>
+#include <string>
+
+using namespace std;
+
+namespace {
+
+size_t storedRows(Hotel& hotel) {
+    size_t count = 0;
+    std::shared_ptr<const Hotel::Snapshot> view = hotel.snapshot();
+    for (const auto& month : *view->days) {
+        for (const auto& day : *month.second) {
+            Hotel::Snapshot::RowChunks::forEach(*day.second, [&count](const Hotel::Reservation&) { ++count; });
+        }
+    }
+    return count;
+}
+
+// Three one-night Courtyard stays a night, booked ten days ahead, from 200
+// nights before asOf to 60 after
+void writeHistory(int asOf) {
+    for (int day = asOf - 200; day <= asOf + 60; ++day) {
+        const std::string date = Hotel::dayNumberToDate(day);
+        std::string text = "TOTAL_REVENUE=375\n"
+            "GuestName,RoomNumber,RoomType,StayDate,Nights,CheckInHour,PricePerNight,TotalCost,BookedOn\n";
+        for (int room = 101; room <= 103; ++room) {
+            text += "G" + std::to_string(day) + "-" + std::to_string(room) + "," + std::to_string(room) +
+                    ",\"Standard Rooms, Courtyard\"," + date + ",1,15,125,125," +
+                    Hotel::dayNumberToDate(day - 10) + "\n";
+        }
+        writeFile(date + ".txt", text);
+    }
+}
+
+bool same(double a, double b) { return std::abs(a - b) <= 1e-6 * std::max(1.0, std::abs(b)); }
+
+} // namespace
+
+int main() {
+    ScratchDir scratch("hotel_forecast_test");
+    const std::string asOf = "06-01-2025";
+    const int asOfDay = Hotel::dateToDayNumber(asOf);
+    writeHistory(asOfDay);
+    const std::string later = Hotel::dayNumberToDate(asOfDay + 5);
+
+    // Forecast, then a booking that merges a file the forecast read
+    HiltonHotel attached(122);
+    attached.attachHistory(".");
+    attached.loadFromFile(asOf);
+    const size_t before = storedRows(attached);
+    const double first = attached.forecast()->totalRevenue;
+    expect(storedRows(attached) == before, "forecast leaves the stored rows as they were");
+    expect(first > 0.0, "forecast reads the rows on file");
+    attached.reserveRoom(4, "Late", later, later, 15, 1);
+    const double refreshed = attached.forecast()->totalRevenue;
+
+    // The same booking first, then the forecast
+    HiltonHotel fresh(122);
+    fresh.attachHistory(".");
+    fresh.loadFromFile(asOf);
+    fresh.reserveRoom(4, "Late", later, later, 15, 1);
+    const double rebuilt = fresh.forecast()->totalRevenue;
+    expect(same(refreshed, rebuilt), "rows merged after the forecast are counted once (" +
+           std::to_string(refreshed) + " vs " + std::to_string(rebuilt) + ")");
+
+    // Imported instead of attached: the same forecast
+    HiltonHotel imported(122);
+    imported.loadFromFile(asOf);
+    imported.importDirectory(".");
+    expect(same(imported.forecast()->totalRevenue, first), "attached and imported forecasts agree");
+
+    std::cout << "forecast: " << failures() << " failure(s)\n";
+    return failures() == 0 ? 0 : 1;
+}
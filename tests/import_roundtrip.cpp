@@ -0,0 +1,104 @@
+// Day files written by one hotel must import into another unchanged.
+//
+// Usage: hotel_import_test
+//
+// A Hilton books every room type, whose names include commas, for guests
+// whose names include commas, and saves each date. A second Hilton imports
+// the files, together with a file written before fields were quoted, and
+// must hold the same rows. Exits non-zero on any difference.
+#include "hotel.h"
+
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <set>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace std;
+namespace fs = std::filesystem;
+
+namespace {
+
+// Every stored row of a hotel, one line per row
+std::multiset<std::string> storedRows(Hotel& hotel) {
+    std::multiset<std::string> rows;
+    std::shared_ptr<const Hotel::Snapshot> view = hotel.snapshot();
+    for (const auto& month : *view->days) {
+        for (const auto& day : *month.second) {
+            Hotel::Snapshot::RowChunks::forEach(*day.second, [&rows](const Hotel::Reservation& r) {
+                std::ostringstream line;
+                line << r.stayDate << " | " << r.roomNumber << " | " << r.roomType << " | "
+                     << r.guestName << " | " << r.nights << " | " << r.checkInHour << " | "
+                     << r.pricePerNight << " | " << r.totalCost;
+                rows.insert(line.str());
+            });
+        }
+    }
+    return rows;
+}
+
+} // namespace
+
+int main() {
+    std::error_code ec;
+    const fs::path originalDir = fs::current_path();
+    const fs::path scratch = fs::temp_directory_path() /
+        ("hotel_import_test_" + std::to_string(std::chrono::steady_clock::now().time_since_epoch().count()));
+    const fs::path files = scratch / "files";
+    const fs::path work = scratch / "work";
+    fs::create_directories(files);
+    fs::create_directories(work);
+
+    // Written by the source hotel, in its working directory
+    fs::current_path(files);
+    std::multiset<std::string> expected;
+    {
+        HiltonHotel source(122);
+        const char* days[] = { "03-01-2025", "03-02-2025", "03-03-2025", "03-04-2025" };
+        int guest = 0;
+        for (const char* day : days) {
+            for (int option = 1; option <= 4; ++option) {
+                source.reserveRoom(option, "Guest, " + std::to_string(++guest), day, day, 15, 1 + option % 3);
+            }
+            source.saveToFile(day);
+        }
+        expected = storedRows(source);
+    }
+
+    // Written before fields were quoted: the room type's comma is bare
+    {
+        std::ofstream legacy("02-20-2025.txt");
+        legacy << "TOTAL_REVENUE=375\n"
+               << "GuestName,RoomNumber,RoomType,StayDate,Nights,CheckInHour,PricePerNight,TotalCost\n"
+               << "Kim,101,Standard Rooms, Courtyard,02-20-2025,3,12,125,375\n";
+    }
+    expected.insert("02-20-2025 | 101 | Standard Rooms, Courtyard | Kim | 3 | 12 | 125 | 375");
+
+    fs::current_path(work);
+    std::multiset<std::string> imported;
+    Hotel::ImportReport report;
+    {
+        HiltonHotel target(122);
+        report = target.importDirectory(files.string());
+        imported = storedRows(target);
+    }
+    fs::current_path(originalDir);
+    fs::remove_all(scratch, ec);
+
+    bool passed = imported == expected && report.conflicts.empty();
+    std::cout << "import round trip: " << report.imported << " of " << expected.size()
+              << " rows imported, " << report.conflicts.size() << " conflict(s)\n";
+    for (const std::string& conflict : report.conflicts) std::cout << "  conflict: " << conflict << "\n";
+    if (!passed) {
+        for (const std::string& row : expected) {
+            if (!imported.count(row)) std::cout << "  missing:  " << row << "\n";
+        }
+        for (const std::string& row : imported) {
+            if (!expected.count(row)) std::cout << "  extra:    " << row << "\n";
+        }
+    }
+    return passed ? 0 : 1;
+}
@@ -0,0 +1,85 @@
+// Day files read on demand must answer like the files themselves, stay
+// under their byte budget, and follow a file that changes.
+//
+// Usage: hotel_history_test
+#include "history.h"
+#include "test_support.h"
+
+#include <iostream>
+#include <memory>
+#include <string>
+
+using namespace std;
+
+namespace {
+
+// Two Courtyard stays a night for 90 nights from firstDay, with Ada in
+// room 103 every seventh night
+void writeHistory(int firstDay) {
+    for (int day = firstDay; day < firstDay + 90; ++day) {
+        const std::string date = Hotel::dayNumberToDate(day);
+        std::string text = "TOTAL_REVENUE=250\n"
+            "GuestName,RoomNumber,RoomType,StayDate,Nights,CheckInHour,PricePerNight,TotalCost,BookedOn\n";
+        for (int room = 101; room <= 102; ++room) {
+            text += "G" + std::to_string(day) + "-" + std::to_string(room) + "," + std::to_string(room) +
+                    ",\"Standard Rooms, Courtyard\"," + date + ",1,15,125,125,\n";
+        }
+        if ((day - firstDay) % 7 == 0) {
+            text += "\"Lovelace, Ada\",103,\"Standard Rooms, Courtyard\"," + date + ",2,15,125,250,\n";
+        }
+        writeFile(date + ".txt", text);
+    }
+}
+
+} // namespace
+
+int main() {
+    ScratchDir scratch("hotel_history_test");
+    const int firstDay = Hotel::dateToDayNumber("01-01-2026");
+    writeHistory(firstDay);
+
+    // Nothing is read until asked for; a page reads its file's rows once
+    const size_t budget = 16u << 10;
+    HistoryStore store(".", budget);
+    expect(store.stats().dayMisses == 0 && store.stats().residentEntries == 0, "nothing is read up front");
+    const std::string firstDate = Hotel::dayNumberToDate(firstDay);
+    std::shared_ptr<const HistoryStore::DayPage> first = store.day(firstDate);
+    expect(first && first->rows.size() == 3 && first->totalRevenue == 250.0, "a page holds its file's rows");
+    expect(first && first->rows[2].guestName == "Lovelace, Ada" &&
+           first->rows[2].roomType == "Standard Rooms, Courtyard", "quoted fields keep their commas");
+    store.day(firstDate);
+    expect(store.stats().dayMisses == 1 && store.stats().dayHits == 1, "a second read of a page is a hit");
+    expect(!store.day("12-31-2025"), "a date without a file has no page");
+
+    // Every stay of a guest, in date order, across the months
+    std::vector<HistoryStore::GuestStay> stays = store.findGuest("Lovelace, Ada");
+    expect(stays.size() == 13, "findGuest finds every stay (" + std::to_string(stays.size()) + ")");
+    for (size_t i = 0; i < stays.size(); ++i) {
+        expect(stays[i].date == Hotel::dayNumberToDate(firstDay + 7 * static_cast<int>(i)) &&
+               stays[i].roomNumber == 103 && stays[i].nights == 2, "stay " + std::to_string(i) + " is on file");
+    }
+    expect(store.findGuest("Nobody").empty(), "an unknown guest has no stays");
+
+    // Walking every page keeps the store under budget; pages handed out survive
+    for (int day = firstDay; day < firstDay + 90; ++day) {
+        store.day(Hotel::dayNumberToDate(day));
+    }
+    HistoryStore::Stats stats = store.stats();
+    expect(stats.evictions > 0, "pages past the budget are evicted");
+    expect(stats.residentBytes <= static_cast<long long>(budget), "the store stays under its budget");
+    expect(first->rows.size() == 3 && first->rows[0].roomNumber == 101, "an evicted page stays valid");
+
+    // A changed file is read again once invalidated
+    const std::string date = Hotel::dayNumberToDate(firstDay + 1);
+    store.day(date);
+    writeFile(date + ".txt", "TOTAL_REVENUE=125\n"
+              "GuestName,RoomNumber,RoomType,StayDate,Nights,CheckInHour,PricePerNight,TotalCost,BookedOn\n"
+              "New,104,\"Standard Rooms, Courtyard\"," + date + ",1,15,125,125,\n");
+    store.invalidate(date);
+    std::shared_ptr<const HistoryStore::DayPage> changed = store.day(date);
+    expect(changed && changed->rows.size() == 1 && changed->rows[0].guestName == "New",
+           "an invalidated page is read again");
+
+    std::cout << "history: " << failures() << " failure(s)\n";
+    return failures() == 0 ? 0 : 1;
+}
@@ -0,0 +1,76 @@
+// Re-optimization must not move a stay onto a room that a stay on file,
+// never loaded, still holds, and a flush must never drop a row on file.
+//
+// Usage: hotel_reoptimize_test
+#include "hotel.h"
+#include "test_support.h"
+
+#include <cstdlib>
+#include <iostream>
+#include <string>
+
+using namespace std;
+
+namespace {
+
+const char* const dayFile =
+    "TOTAL_REVENUE=2625\n"
+    "GuestName,RoomNumber,RoomType,StayDate,Nights,CheckInHour,PricePerNight,TotalCost,BookedOn\n"
+    "Long,101,\"Standard Rooms, Courtyard\",01-05-2026,20,15,125,2500,\n"
+    "Short,102,\"Standard Rooms, Courtyard\",01-05-2026,1,15,125,125,\n";
+
+// Long is merged by A's lookback, Short (one night) never is
+void runScenario(bool bestFit) {
+    const std::string label = bestFit ? "best-fit: " : "first-fit: ";
+    ScratchDir scratch("hotel_reoptimize_test");
+    writeFile("01-05-2026.txt", dayFile);
+
+    HiltonHotel hotel(122);
+    hotel.setBestFitAssignment(bestFit);
+    hotel.loadFromFile("01-01-2026");
+    const int courtyard = 4;
+    hotel.reserveRoom(courtyard, "C", "01-27-2026", "01-27-2026", 15, 25);
+    hotel.reserveRoom(courtyard, "B", "01-25-2026", "01-25-2026", 15, 30);
+    hotel.reserveRoom(courtyard, "A", "01-20-2026", "01-20-2026", 15, 1);
+
+    hotel.reoptimizeAssignments("01-01-2026");
+    hotel.flushDirty();
+
+    // Both stays still on file, on different rooms, for the same revenue
+    const std::string text = readFile("01-05-2026.txt");
+    auto roomOf = [&text](const std::string& guest) {
+        size_t at = text.find("\n" + guest + ",");
+        return at == std::string::npos ? -1 : std::atoi(text.c_str() + at + guest.size() + 2);
+    };
+    expect(roomOf("Long") > 0, label + "Long is still on file");
+    expect(roomOf("Short") > 0, label + "Short is still on file");
+    expect(roomOf("Long") != roomOf("Short"), label + "Long and Short hold different rooms");
+    expect(text.rfind("TOTAL_REVENUE=2625\n", 0) == 0, label + "the date's revenue is unchanged");
+}
+
+// A stay in memory on the room of a different stay on file: the flush
+// leaves the file as it is instead of dropping the file's row
+void runClash() {
+    ScratchDir scratch("hotel_reoptimize_test");
+    HiltonHotel hotel(122);
+    hotel.loadFromFile("02-01-2026");
+    hotel.reserveRoom(4, "Memory", "02-01-2026", "02-01-2026", 15, 1);
+    writeFile("02-01-2026.txt",
+              "TOTAL_REVENUE=125\n"
+              "GuestName,RoomNumber,RoomType,StayDate,Nights,CheckInHour,PricePerNight,TotalCost,BookedOn\n"
+              "Disk,101,\"Standard Rooms, Courtyard\",02-01-2026,1,15,125,125,\n");
+
+    hotel.flushDirty();
+    expect(readFile("02-01-2026.txt").find("Disk,101,") != std::string::npos,
+           "clash: the row on file survives the flush");
+}
+
+} // namespace
+
+int main() {
+    runScenario(true);
+    runScenario(false);
+    runClash();
+    std::cout << "reoptimize and flush: " << failures() << " failure(s)\n";
+    return failures() == 0 ? 0 : 1;
+}
@@ -0,0 +1,57 @@
+// Shard workers answer revenue and guest queries from their day files, so
+// a restarted deployment reports what was booked before it stopped.
+//
+// Usage: hotel_shard_test
+#include "hotel.h"
+#include "shard.h"
+#include "test_support.h"
+
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+int main() {
+    ScratchDir scratch("hotel_shard_test");
+    const std::string today = "04-01-2026";
+    std::vector<ShardSpec> specs(2);
+    specs[0].property = "north";
+    specs[1].property = "south";
+    for (ShardSpec& spec : specs) {
+        spec.directory = (scratch.path() / spec.property).string();
+        spec.loadedDate = today;
+    }
+
+    const int from = Hotel::dateToDayNumber(today);
+    const int to = from + 30;
+    double booked = 0.0;
+    {
+        ShardCoordinator coordinator(specs);
+        expect(coordinator.ok(), "first start: " + coordinator.lastError());
+        std::vector<ShardCoordinator::Booking> bookings = {
+            { "north", 4, "Ada", "04-03-2026", 2, 15 },
+            { "south", 2, "Ada", "04-10-2026", 1, 12 },
+            { "south", 3, "Ben", "04-01-2026", 3, 9 },
+        };
+        for (const ShardCoordinator::BookingResult& result : coordinator.reserveBatch(bookings)) {
+            expect(result.ok && result.totalCost > 0.0, "booking: " + result.error);
+            booked += result.totalCost;
+        }
+        ShardCoordinator::RevenueReport report = coordinator.portfolioRevenue(from, to);
+        expect(report.rows == 3 && report.revenue == booked, "revenue before the restart");
+    }
+
+    // Restarted on the same directories: everything comes from the day files
+    ShardCoordinator coordinator(specs);
+    expect(coordinator.ok(), "restart: " + coordinator.lastError());
+    ShardCoordinator::RevenueReport report = coordinator.portfolioRevenue(from, to);
+    expect(report.rows == 3, "rows after the restart: " + std::to_string(report.rows));
+    expect(report.revenue == booked, "revenue after the restart: " + std::to_string(report.revenue) +
+           " vs " + std::to_string(booked));
+    std::vector<ShardCoordinator::GuestStay> stays = coordinator.findGuest("Ada");
+    expect(stays.size() == 2, "Ada's stays after the restart: " + std::to_string(stays.size()));
+
+    std::cout << "shard restart: " << failures() << " failure(s)\n";
+    return failures() == 0 ? 0 : 1;
+}
@@ -0,0 +1,76 @@
+// A published snapshot must not change after later bookings, and each new
+// one must carry them.
+//
+// Usage: hotel_snapshot_test
+#include "hotel.h"
+#include "test_support.h"
+
+#include <iostream>
+#include <memory>
+#include <string>
+
+using namespace std;
+
+namespace {
+
+size_t rowsOn(const Hotel::Snapshot& view, const std::string& date) {
+    const Hotel::Snapshot::DayRows* rows = view.rowsFor(date);
+    size_t count = 0;
+    if (rows) Hotel::Snapshot::RowChunks::forEach(*rows, [&count](const Hotel::Reservation&) { ++count; });
+    return count;
+}
+
+int availableRooms(const Hotel::Snapshot& view) {
+    int rooms = 0;
+    for (const auto& type : view.roomTypes) rooms += type.availableRooms;
+    return rooms;
+}
+
+size_t sessionBookings(const Hotel::Snapshot& view) {
+    size_t count = 0;
+    Hotel::Snapshot::SessionChunks::forEach(view.sessionBookings,
+                                            [&count](const Hotel::Snapshot::SessionBooking&) { ++count; });
+    return count;
+}
+
+} // namespace
+
+int main() {
+    ScratchDir scratch("hotel_snapshot_test");
+    const std::string date = "04-01-2026";
+    const std::string later = "04-02-2026";
+
+    HiltonHotel hotel(122);
+    hotel.loadFromFile(date);
+    hotel.reserveRoom(4, "First", date, date, 15, 1);
+    std::shared_ptr<const Hotel::Snapshot> before = hotel.snapshot();
+    const double revenueBefore = before->totalRevenue;
+    const int availableBefore = availableRooms(*before);
+
+    // Enough bookings on one date to fill more than one row chunk
+    size_t booked = 0;
+    for (int i = 0; i < 100; ++i) {
+        if (hotel.reserveRoom(1 + i % 4, "Guest " + std::to_string(i), date, date, 15, 1) >= 0) ++booked;
+    }
+    expect(booked > 64, "the bookings fill more than one row chunk (" + std::to_string(booked) + ")");
+    hotel.reserveRoom(3, "Later", later, later, 15, 1);
+    std::shared_ptr<const Hotel::Snapshot> after = hotel.snapshot();
+
+    expect(after->version > before->version, "each publish has a newer version");
+    expect(rowsOn(*before, date) == 1 && !before->rowsFor(later), "the old snapshot keeps its rows");
+    expect(before->totalRevenue == revenueBefore && availableRooms(*before) == availableBefore,
+           "the old snapshot keeps its totals");
+    expect(sessionBookings(*before) == 1, "the old snapshot keeps its session bookings");
+    expect(rowsOn(*after, date) == rowsOn(*before, date) + booked && rowsOn(*after, later) == 1,
+           "the new snapshot has the new bookings");
+    expect(after->totalRevenue > revenueBefore, "the new snapshot has the new revenue");
+
+    // Undo publishes a snapshot without the booking; the earlier one keeps it
+    expect(hotel.undoLastBooking(), "the last booking can be undone");
+    std::shared_ptr<const Hotel::Snapshot> undone = hotel.snapshot();
+    expect(!undone->rowsFor(later) || rowsOn(*undone, later) == 0, "undo removes the row");
+    expect(rowsOn(*after, later) == 1, "the snapshot before the undo keeps the row");
+
+    std::cout << "snapshot: " << failures() << " failure(s)\n";
+    return failures() == 0 ? 0 : 1;
+}
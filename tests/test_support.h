@@ -0,0 +1,62 @@
+#ifndef HOTEL_TEST_SUPPORT_H
+#define HOTEL_TEST_SUPPORT_H
+
+// Shared by the ctest programs in this directory: a scratch working
+// directory per test and a failure counter.
+
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+
+// Makes a fresh directory under the system temp directory the working
+// directory, and restores the old one and removes it when done
+class ScratchDir {
+public:
+    explicit ScratchDir(const std::string& name)
+        : original(std::filesystem::current_path()),
+          dir(std::filesystem::temp_directory_path() /
+              (name + "_" + std::to_string(std::chrono::steady_clock::now().time_since_epoch().count()))) {
+        std::filesystem::create_directories(dir);
+        std::filesystem::current_path(dir);
+    }
+    ~ScratchDir() {
+        std::error_code ec;
+        std::filesystem::current_path(original, ec);
+        std::filesystem::remove_all(dir, ec);
+    }
+
+    const std::filesystem::path& path() const { return dir; }
+
+private:
+    std::filesystem::path original;
+    std::filesystem::path dir;
+};
+
+// Counts and prints failed checks; main returns failures() != 0
+inline int& failures() {
+    static int count = 0;
+    return count;
+}
+
+inline void expect(bool ok, const std::string& what) {
+    if (!ok) {
+        ++failures();
+        std::cout << "FAILED: " << what << "\n";
+    }
+}
+
+inline std::string readFile(const std::string& path) {
+    std::ifstream in(path);
+    std::ostringstream text;
+    text << in.rdbuf();
+    return text.str();
+}
+
+inline void writeFile(const std::string& path, const std::string& text) {
+    std::ofstream(path) << text;
+}
+
+#endif // HOTEL_TEST_SUPPORT_H
@@ -0,0 +1,64 @@
+// A turnover plan must list the stays on file that check out on its date,
+// not only the ones booked in this session.
+//
+// Usage: hotel_turnover_test
+#include "hotel.h"
+#include "test_support.h"
+
+#include <iostream>
+#include <sstream>
+#include <string>
+
+using namespace std;
+
+namespace {
+
+const char* const header =
+    "GuestName,RoomNumber,RoomType,StayDate,Nights,CheckInHour,PricePerNight,TotalCost,BookedOn\n";
+
+// Stays checked in before 12-14-2025: two leave on it, one runs through it
+void writeHistory() {
+    writeFile("12-01-2025.txt", std::string("TOTAL_REVENUE=1450\n") + header +
+              "Resident,202,\"Standard Room, Scenic\",12-01-2025,20,15,145,2900,\n");
+    writeFile("12-12-2025.txt", std::string("TOTAL_REVENUE=2270\n") + header +
+              "Penthouse Stay,301,Penthouse,12-12-2025,2,15,1135,2270,\n");
+    writeFile("12-13-2025.txt", std::string("TOTAL_REVENUE=145\n") + header +
+              "Scenic Stay,201,\"Standard Room, Scenic\",12-13-2025,1,15,145,145,\n");
+}
+
+std::string planFor(Hotel& hotel, const std::string& date) {
+    std::ostringstream text;
+    std::streambuf* console = std::cout.rdbuf(text.rdbuf());
+    hotel.showTurnoverPlan(date, 2);
+    std::cout.rdbuf(console);
+    return text.str();
+}
+
+void checkPlan(const std::string& plan, const std::string& how) {
+    expect(plan.find("out: Penthouse Stay") != std::string::npos, how + ": the Penthouse departure is planned");
+    expect(plan.find("out: Scenic Stay") != std::string::npos, how + ": the Scenic departure is planned");
+    expect(plan.find("in: Arrival") != std::string::npos, how + ": the arrival is planned");
+    expect(plan.find("Resident") == std::string::npos, how + ": a stay running through the date has no task");
+}
+
+} // namespace
+
+int main() {
+    ScratchDir scratch("hotel_turnover_test");
+    writeHistory();
+    const std::string date = "12-14-2025";
+
+    HiltonHotel loaded(122);
+    loaded.loadFromFile(date);
+    loaded.reserveRoom(2, "Arrival", date, date, 14, 1);
+    checkPlan(planFor(loaded, date), "day files");
+
+    HiltonHotel attached(122);
+    attached.attachHistory(".");
+    attached.loadFromFile(date);
+    attached.reserveRoom(2, "Arrival", date, date, 14, 1);
+    checkPlan(planFor(attached, date), "attached history");
+
+    std::cout << "turnover: " << failures() << " failure(s)\n";
+    return failures() == 0 ? 0 : 1;
+}